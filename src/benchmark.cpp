@@ -0,0 +1,681 @@
+#include "benchmark.h"
+#include "bfh.h"
+#include <iostream>
+#include <format>
+#include <random>
+#include <cmath>
+#include <chrono>
+#include <algorithm>
+#include <thread>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+//=====================================================================================
+//                              Shared Helpers
+//=====================================================================================
+
+std::vector<std::pair<int, int>> sampleActorPairs(const Graph& graph, int count, unsigned int seed) {
+    std::vector<std::pair<int, int>> pairs;
+    if (graph.getActorCount() == 0) {
+        return pairs;
+    }
+
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> pick(0, static_cast<int>(graph.getActorCount()) - 1);
+    for (int i = 0; i < count; i++) {
+        pairs.emplace_back(graph.getActorId(pick(rng)), graph.getActorId(pick(rng)));
+    }
+    return pairs;
+}
+
+std::vector<unsigned int> doublingThreadCounts(unsigned int minimumMax) {
+    std::vector<unsigned int> threadCounts;
+    unsigned int maxThreads = std::max({ 1u, minimumMax, std::thread::hardware_concurrency() });
+    for (unsigned int threads = 1; threads < maxThreads; threads *= 2) {
+        threadCounts.push_back(threads);
+    }
+    threadCounts.push_back(maxThreads);
+    return threadCounts;
+}
+
+bool isValidPath(const Graph& graph, const PathResult& result, int startActorId, int endActorId) {
+    if (!result.pathExists) {
+        return true;
+    }
+    if (result.path.empty() || result.path.front() != startActorId || result.path.back() != endActorId) {
+        return false;
+    }
+    if (result.hopCount != static_cast<int>(result.path.size()) - 1) {
+        return false;
+    }
+
+    int totalWeight = 0;
+    for (size_t i = 0; i + 1 < result.path.size(); i++) {
+        int weight = graph.getEdgeWeight(result.path[i], result.path[i + 1]);
+        if (weight == 0) {
+            return false;
+        }
+        totalWeight += weight;
+    }
+    return totalWeight == result.totalWeight;
+}
+
+//=====================================================================================
+//                              BFS Comparisons
+//=====================================================================================
+
+bool compareBFSModes(const Graph& graph, int samples, unsigned int seed) {
+    std::cout << std::format("\n=== BFS Modes ({} pairs) ===\n", samples);
+
+    // Every faster mode is checked against the original BFS
+    struct Mode {
+        const char* name;
+        PathResult (*run)(const Graph&, int, int);
+        double time = 0.0;
+        long long expanded = 0;
+        int mismatches = 0;
+    };
+    std::vector<Mode> modes = {
+        { "BFS", BFS::findShortestPath },
+        { "Bidirectional", BFS::findShortestPathBidirectional },
+        { "Direction-Optimizing", BFS::findShortestPathDirectionOptimizing }
+    };
+
+    int tableMismatches = 0;
+    double tableTime = 0.0;
+    int tableCount = 0;
+
+    for (const auto& [startId, endId] : sampleActorPairs(graph, samples, seed)) {
+        PathResult base;
+        for (Mode& mode : modes) {
+            PathResult result = mode.run(graph, startId, endId);
+            mode.time += result.executionTimeMs;
+            mode.expanded += result.nodesExpanded;
+
+            if (&mode == &modes.front()) {
+                base = result;
+            }
+            else if (base.pathExists != result.pathExists || base.hopCount != result.hopCount ||
+                !isValidPath(graph, result, startId, endId)) {
+                std::cerr << std::format("{} mismatch for ({}, {}): {} hops vs {} hops\n",
+                    mode.name, startId, endId, base.hopCount, result.hopCount);
+                mode.mismatches++;
+            }
+        }
+
+        // Full distance tables are slower, so only check a handful of them
+        if (tableCount < 10) {
+            DistanceTable table = BFS::computeDistanceTable(graph, startId);
+            int tableHops = table.distance[graph.getIndex(endId)];
+            if (tableHops != (base.pathExists ? base.hopCount : -1)) {
+                std::cerr << std::format("Distance table mismatch for ({}, {}): {} hops vs {} hops\n",
+                    startId, endId, base.hopCount, tableHops);
+                tableMismatches++;
+            }
+            tableTime += table.executionTimeMs;
+            tableCount++;
+        }
+    }
+
+    int mismatches = tableMismatches;
+    for (const Mode& mode : modes) {
+        std::cout << std::format("{:<22}{:>12.3f} ms total, {} actors expanded, {} mismatches\n",
+            mode.name, mode.time, mode.expanded, mode.mismatches);
+        mismatches += mode.mismatches;
+    }
+    std::cout << std::format("{:<22}{:>12.3f} ms average, {} mismatches\n", "Distance Table",
+        tableCount > 0 ? tableTime / tableCount : 0.0, tableMismatches);
+    std::cout << "============================\n\n";
+    return mismatches == 0;
+}
+
+bool compareHopLabels(const Graph& graph, const HopLabelIndex& labels, int samples, unsigned int seed) {
+    std::cout << std::format("\n=== Hop Labels ({} pairs) ===\n", samples);
+
+    double bfsTime = 0.0;
+    double pathTime = 0.0;
+    double distanceTime = 0.0;
+    int mismatches = 0;
+
+    for (const auto& [startId, endId] : sampleActorPairs(graph, samples, seed)) {
+        PathResult base = BFS::findShortestPath(graph, startId, endId);
+        PathResult result = BFS::findShortestPathLabeled(graph, labels, startId, endId);
+        bfsTime += base.executionTimeMs;
+        pathTime += result.executionTimeMs;
+
+        auto startTime = std::chrono::high_resolution_clock::now();
+        int hops = BFS::getDegreesOfSeparation(graph, labels, startId, endId);
+        auto endTime = std::chrono::high_resolution_clock::now();
+        distanceTime += std::chrono::duration<double, std::milli>(endTime - startTime).count();
+
+        int baseHops = base.pathExists ? base.hopCount : -1;
+        if (base.pathExists != result.pathExists || base.hopCount != result.hopCount || hops != baseHops ||
+            !isValidPath(graph, result, startId, endId)) {
+            std::cerr << std::format("Hop label mismatch for ({}, {}): {} hops vs {} (path) / {} (distance)\n",
+                startId, endId, baseHops, result.hopCount, hops);
+            mismatches++;
+        }
+    }
+
+    std::cout << std::format("{:<22}{:>12.3f} ms total\n", "BFS", bfsTime);
+    std::cout << std::format("{:<22}{:>12.3f} ms total\n", "Labeled Path", pathTime);
+    std::cout << std::format("{:<22}{:>12.3f} us average, {} mismatches\n", "Labeled Distance",
+        samples > 0 ? distanceTime * 1000.0 / samples : 0.0, mismatches);
+    std::cout << "============================\n\n";
+    return mismatches == 0;
+}
+
+bool compareParallelDistanceTable(const Graph& graph, int samples, unsigned int seed) {
+    std::cout << std::format("\n=== Parallel Distance Table ({} sources) ===\n", samples);
+
+    // Doubling thread counts up to every core
+    std::vector<unsigned int> threadCounts = doublingThreadCounts();
+
+    double baseTime = 0.0;
+    std::vector<double> parallelTime(threadCounts.size(), 0.0);
+    int mismatches = 0;
+
+    for (const auto& [startId, endId] : sampleActorPairs(graph, samples, seed)) {
+        DistanceTable base = BFS::computeDistanceTable(graph, startId);
+        baseTime += base.executionTimeMs;
+
+        for (size_t i = 0; i < threadCounts.size(); i++) {
+            DistanceTable table = BFS::computeDistanceTableParallel(graph, startId, threadCounts[i]);
+            parallelTime[i] += table.executionTimeMs;
+
+            // Same distances and histogram, and every parent one hop closer to the source
+            bool valid = table.distance == base.distance && table.histogram == base.histogram &&
+                table.reachableCount == base.reachableCount;
+            for (size_t index = 0; valid && index < table.parent.size(); index++) {
+                int parent = table.parent[index];
+                if (parent != -1) {
+                    valid = table.distance[parent] == table.distance[index] - 1 &&
+                        graph.getEdgeWeight(graph.getActorId(parent), graph.getActorId(static_cast<int>(index))) > 0;
+                }
+            }
+            if (!valid) {
+                std::cerr << std::format("Parallel distance table mismatch from {} with {} threads\n",
+                    startId, threadCounts[i]);
+                mismatches++;
+            }
+        }
+    }
+
+    std::cout << std::format("{:<22}{:>12.3f} ms average\n", "Direction-Optimizing",
+        samples > 0 ? baseTime / samples : 0.0);
+    for (size_t i = 0; i < threadCounts.size(); i++) {
+        std::cout << std::format("{:<22}{:>12.3f} ms average\n", std::format("{} Threads", threadCounts[i]),
+            samples > 0 ? parallelTime[i] / samples : 0.0);
+    }
+    std::cout << std::format("{} mismatches\n", mismatches);
+    std::cout << "============================\n\n";
+    return mismatches == 0;
+}
+
+bool compareDistanceMatrix(const Graph& graph, int sourceCount, int targetCount, unsigned int seed) {
+    std::cout << std::format("\n=== Distance Matrix ({} x {}) ===\n", sourceCount, targetCount);
+
+    // Sources from the start of the sampled pairs and targets from the end, so the two don't overlap
+    std::vector<int> sourceIds;
+    std::vector<int> targetIds;
+    for (const auto& [startId, endId] : sampleActorPairs(graph, std::max(sourceCount, targetCount), seed)) {
+        if (static_cast<int>(sourceIds.size()) < sourceCount) {
+            sourceIds.push_back(startId);
+        }
+        if (static_cast<int>(targetIds.size()) < targetCount) {
+            targetIds.push_back(endId);
+        }
+    }
+
+    DistanceMatrix matrix = BFS::computeDistanceMatrix(graph, sourceIds, targetIds);
+
+    // The same matrix one pair at a time
+    double bfsTime = 0.0;
+    int mismatches = 0;
+    for (size_t row = 0; row < sourceIds.size(); row++) {
+        for (size_t column = 0; column < targetIds.size(); column++) {
+            PathResult base = BFS::findShortestPath(graph, sourceIds[row], targetIds[column]);
+            bfsTime += base.executionTimeMs;
+
+            int baseHops = base.pathExists ? base.hopCount : -1;
+            if (matrix.getDistance(row, column) != baseHops) {
+                std::cerr << std::format("Distance matrix mismatch for ({}, {}): {} hops vs {} hops\n",
+                    sourceIds[row], targetIds[column], baseHops, matrix.getDistance(row, column));
+                mismatches++;
+            }
+        }
+    }
+
+    std::cout << std::format("{:<22}{:>12.3f} ms total\n", "BFS per Pair", bfsTime);
+    std::cout << std::format("{:<22}{:>12.3f} ms total, {} mismatches\n", "Multi-Source BFS",
+        matrix.executionTimeMs, mismatches);
+    std::cout << "============================\n\n";
+    return mismatches == 0;
+}
+
+//=====================================================================================
+//                              Dijkstra Comparisons
+//=====================================================================================
+
+bool compareDijkstraModes(const Graph& graph, int samples, unsigned int seed) {
+    std::cout << std::format("\n=== Dijkstra Modes ({} pairs) ===\n", samples);
+
+    // Every other queue and mode is checked against the original binary heap search
+    struct Mode {
+        const char* name;
+        PathResult (*run)(const Graph&, int, int);
+        double time = 0.0;
+        long long expanded = 0;
+        int mismatches = 0;
+    };
+    std::vector<Mode> modes = {
+        { "Binary Heap", [](const Graph& g, int startId, int endId) {
+            return Dijkstra::findStrongestPath(g, startId, endId, Dijkstra::QueueType::BinaryHeap); } },
+        { "4-ary Heap", [](const Graph& g, int startId, int endId) {
+            return Dijkstra::findStrongestPath(g, startId, endId, Dijkstra::QueueType::DaryHeap); } },
+        { "Radix Heap", [](const Graph& g, int startId, int endId) {
+            return Dijkstra::findStrongestPath(g, startId, endId, Dijkstra::QueueType::RadixHeap); } },
+        { "Bidirectional", Dijkstra::findStrongestPathBidirectional }
+    };
+
+    for (const auto& [startId, endId] : sampleActorPairs(graph, samples, seed)) {
+        PathResult base;
+        double baseCost = 0.0;
+        for (Mode& mode : modes) {
+            PathResult result = mode.run(graph, startId, endId);
+            mode.time += result.executionTimeMs;
+            mode.expanded += result.nodesExpanded;
+            double cost = Dijkstra::calculatePathCost(graph, result.path);
+
+            if (&mode == &modes.front()) {
+                base = result;
+                baseCost = cost;
+            }
+            else if (base.pathExists != result.pathExists || std::abs(baseCost - cost) > 1e-6 ||
+                !isValidPath(graph, result, startId, endId)) {
+                std::cerr << std::format("{} mismatch for ({}, {}): cost {:.9f} vs {:.9f}\n",
+                    mode.name, startId, endId, baseCost, cost);
+                mode.mismatches++;
+            }
+        }
+    }
+
+    int mismatches = 0;
+    for (const Mode& mode : modes) {
+        std::cout << std::format("{:<22}{:>12.3f} ms total, {} actors expanded, {} mismatches\n",
+            mode.name, mode.time, mode.expanded, mode.mismatches);
+        mismatches += mode.mismatches;
+    }
+    std::cout << "============================\n\n";
+    return mismatches == 0;
+}
+
+bool compareParallelCostTable(const Graph& graph, int samples, unsigned int seed) {
+    std::cout << std::format("\n=== Parallel Cost Table ({} sources) ===\n", samples);
+
+    // Doubling thread counts up to every core
+    std::vector<unsigned int> threadCounts = doublingThreadCounts();
+
+    double baseTime = 0.0;
+    std::vector<double> parallelTime(threadCounts.size(), 0.0);
+    int mismatches = 0;
+
+    for (const auto& [startId, endId] : sampleActorPairs(graph, samples, seed)) {
+        CostTable base = Dijkstra::computeCostTable(graph, startId);
+        baseTime += base.executionTimeMs;
+
+        for (size_t i = 0; i < threadCounts.size(); i++) {
+            CostTable table = Dijkstra::computeCostTableParallel(graph, startId, 0.0, threadCounts[i]);
+            parallelTime[i] += table.executionTimeMs;
+
+            // Same costs, and every parent edge lies on a strongest path
+            bool valid = table.reachableCount == base.reachableCount;
+            for (size_t index = 0; valid && index < table.cost.size(); index++) {
+                valid = table.cost[index] == base.cost[index] ||
+                    std::abs(table.cost[index] - base.cost[index]) < 1e-9;
+                int parent = table.parent[index];
+                if (valid && parent != -1) {
+                    int weight = graph.getEdgeWeight(graph.getActorId(parent), graph.getActorId(static_cast<int>(index)));
+                    valid = weight > 0 && std::abs(table.cost[parent] +
+                        Dijkstra::weightToCost(weight, graph.getMaxWeight()) - table.cost[index]) < 1e-9;
+                }
+            }
+            if (!valid) {
+                std::cerr << std::format("Parallel cost table mismatch from {} with {} threads\n",
+                    startId, threadCounts[i]);
+                mismatches++;
+            }
+        }
+    }
+
+    std::cout << std::format("{:<22}{:>12.3f} ms average\n", "Dijkstra",
+        samples > 0 ? baseTime / samples : 0.0);
+    for (size_t i = 0; i < threadCounts.size(); i++) {
+        std::cout << std::format("{:<22}{:>12.3f} ms average\n", std::format("{} Threads", threadCounts[i]),
+            samples > 0 ? parallelTime[i] / samples : 0.0);
+    }
+    std::cout << std::format("{} mismatches\n", mismatches);
+    std::cout << "============================\n\n";
+    return mismatches == 0;
+}
+
+bool compareLandmarkSearch(const Graph& graph, const LandmarkIndex& landmarks, int samples, unsigned int seed) {
+    std::cout << std::format("\n=== Landmark A* ({} pairs, {} landmarks) ===\n", samples, landmarks.getLandmarks().size());
+
+    double dijkstraTime = 0.0;
+    double aStarTime = 0.0;
+    long long dijkstraExpanded = 0;
+    long long aStarExpanded = 0;
+    int mismatches = 0;
+
+    for (const auto& [startId, endId] : sampleActorPairs(graph, samples, seed)) {
+        PathResult base = Dijkstra::findStrongestPath(graph, startId, endId);
+        PathResult result = Dijkstra::findStrongestPathAStar(graph, landmarks, startId, endId);
+        dijkstraTime += base.executionTimeMs;
+        aStarTime += result.executionTimeMs;
+        dijkstraExpanded += base.nodesExpanded;
+        aStarExpanded += result.nodesExpanded;
+
+        double baseCost = Dijkstra::calculatePathCost(graph, base.path);
+        double cost = Dijkstra::calculatePathCost(graph, result.path);
+        if (base.pathExists != result.pathExists || std::abs(baseCost - cost) > 1e-6 ||
+            !isValidPath(graph, result, startId, endId)) {
+            std::cerr << std::format("A* mismatch for ({}, {}): cost {:.9f} vs {:.9f}\n",
+                startId, endId, baseCost, cost);
+            mismatches++;
+        }
+    }
+
+    std::cout << std::format("{:<22}{:>12.3f} ms total, {} actors expanded\n", "Dijkstra", dijkstraTime, dijkstraExpanded);
+    std::cout << std::format("{:<22}{:>12.3f} ms total, {} actors expanded, {} mismatches\n",
+        "A* (Landmarks)", aStarTime, aStarExpanded, mismatches);
+    std::cout << "============================\n\n";
+    return mismatches == 0;
+}
+
+bool compareContractionHierarchy(const Graph& graph, const ContractionHierarchy& hierarchy, int samples, unsigned int seed) {
+    std::cout << std::format("\n=== Contraction Hierarchy ({} pairs) ===\n", samples);
+
+    double dijkstraTime = 0.0;
+    double hierarchyTime = 0.0;
+    long long dijkstraExpanded = 0;
+    long long hierarchyExpanded = 0;
+    int mismatches = 0;
+
+    // Equal weights around a 4-cycle: 10 and 11 get contracted in the same round, and each is a
+    // witness for the other's neighbor pair, so the hierarchy must not count on both of them
+    {
+        Graph cycle;
+        for (int actorId : { 10, 11, 12, 13 }) {
+            cycle.addActor(actorId, std::format("Actor {}", actorId));
+        }
+        cycle.addEdge(12, 10, 1);
+        cycle.addEdge(10, 13, 1);
+        cycle.addEdge(13, 11, 1);
+        cycle.addEdge(11, 12, 1);
+        cycle.finalize();
+
+        ContractionHierarchy cycleHierarchy;
+        cycleHierarchy.build(cycle);
+        PathResult result = Dijkstra::findStrongestPathCH(cycle, cycleHierarchy, 12, 13);
+        if (!result.pathExists || result.path.size() != 3 || !isValidPath(cycle, result, 12, 13)) {
+            std::cerr << "Contraction hierarchy lost the path across a 4-cycle\n";
+            mismatches++;
+        }
+    }
+
+    for (const auto& [startId, endId] : sampleActorPairs(graph, samples, seed)) {
+        PathResult base = Dijkstra::findStrongestPath(graph, startId, endId);
+        PathResult result = Dijkstra::findStrongestPathCH(graph, hierarchy, startId, endId);
+        dijkstraTime += base.executionTimeMs;
+        hierarchyTime += result.executionTimeMs;
+        dijkstraExpanded += base.nodesExpanded;
+        hierarchyExpanded += result.nodesExpanded;
+
+        double baseCost = Dijkstra::calculatePathCost(graph, base.path);
+        double cost = Dijkstra::calculatePathCost(graph, result.path);
+        if (base.pathExists != result.pathExists || std::abs(baseCost - cost) > 1e-6 ||
+            !isValidPath(graph, result, startId, endId)) {
+            std::cerr << std::format("Contraction hierarchy mismatch for ({}, {}): cost {:.9f} vs {:.9f}\n",
+                startId, endId, baseCost, cost);
+            mismatches++;
+        }
+    }
+
+    std::cout << std::format("{:<22}{:>12.3f} ms total, {} actors expanded\n", "Dijkstra", dijkstraTime, dijkstraExpanded);
+    std::cout << std::format("{:<22}{:>12.3f} ms total, {} actors expanded, {} mismatches\n",
+        "Hierarchy", hierarchyTime, hierarchyExpanded, mismatches);
+    std::cout << "============================\n\n";
+    return mismatches == 0;
+}
+
+//=====================================================================================
+//                              Graph Layout Comparisons
+//=====================================================================================
+
+bool compareIndexOrders(Graph& graph, int samples, unsigned int seed) {
+    std::cout << std::format("\n=== Index Orders ({} sources) ===\n", samples);
+
+    // Actor IDs stay the same in every order, so the same sources are searched each time
+    std::vector<int> sourceIds;
+    for (const auto& [startId, endId] : sampleActorPairs(graph, samples, seed)) {
+        sourceIds.push_back(startId);
+    }
+
+    const std::pair<Graph::IndexOrder, const char*> orders[] = {
+        { Graph::IndexOrder::ActorId, "Actor ID" },
+        { Graph::IndexOrder::Degree, "Degree" },
+        { Graph::IndexOrder::CuthillMcKee, "Reverse Cuthill-McKee" }
+    };
+
+    // Results of the first order, with every array put in actor ID order to compare across orders
+    std::vector<std::vector<int>> baseDistances;
+    std::vector<std::vector<double>> baseCosts;
+    int mismatches = 0;
+
+    std::cout << std::format("{:<22}{:>12}{:>12}{:>12}{:>12}\n", "Order", "Lines/Edge", "Pages/Edge", "BFS ms", "Dijkstra ms");
+    for (const auto& [order, orderName] : orders) {
+        graph.reorder(order);
+        const int count = static_cast<int>(graph.getActorCount());
+
+        // Every ID must still translate to an index holding that ID
+        std::vector<int> indexById(count);
+        for (int index = 0; index < count; index++) {
+            indexById[index] = index;
+        }
+        std::sort(indexById.begin(), indexById.end(),
+            [&](int a, int b) { return graph.getActorId(a) < graph.getActorId(b); });
+        for (int index : indexById) {
+            if (graph.getIndex(graph.getActorId(index)) != index) {
+                std::cerr << std::format("{} order translates actor {} to the wrong index\n", orderName, graph.getActorId(index));
+                mismatches++;
+                break;
+            }
+        }
+
+        // Cache lines (64 bytes) and pages (4 KB) of a per-actor int array, like the distances or
+        // parents, that scanning every row touches. A row touches each of them once, since it is sorted
+        size_t lines = 0;
+        size_t pages = 0;
+        for (int index = 0; index < count; index++) {
+            int lastLine = -1;
+            int lastPage = -1;
+            for (int neighborIndex : graph.getNeighborIndices(index)) {
+                lines += (neighborIndex / 16 != lastLine);
+                pages += (neighborIndex / 1024 != lastPage);
+                lastLine = neighborIndex / 16;
+                lastPage = neighborIndex / 1024;
+            }
+        }
+
+        double bfsTime = 0.0;
+        double dijkstraTime = 0.0;
+        for (size_t s = 0; s < sourceIds.size(); s++) {
+            DistanceTable distances = BFS::computeDistanceTable(graph, sourceIds[s]);
+            CostTable costs = Dijkstra::computeCostTable(graph, sourceIds[s]);
+            bfsTime += distances.executionTimeMs;
+            dijkstraTime += costs.executionTimeMs;
+
+            std::vector<int> distanceById(count);
+            std::vector<double> costById(count);
+            for (int k = 0; k < count; k++) {
+                distanceById[k] = distances.distance[indexById[k]];
+                costById[k] = costs.cost[indexById[k]];
+            }
+
+            if (baseDistances.size() < sourceIds.size()) {
+                baseDistances.push_back(std::move(distanceById));
+                baseCosts.push_back(std::move(costById));
+                continue;
+            }
+
+            // Equally strong paths can be found in another order, so costs may differ by rounding
+            bool valid = distanceById == baseDistances[s];
+            for (int k = 0; valid && k < count; k++) {
+                valid = costById[k] == baseCosts[s][k] || std::abs(costById[k] - baseCosts[s][k]) < 1e-9;
+            }
+            if (!valid) {
+                std::cerr << std::format("{} order gave different tables from {}\n", orderName, sourceIds[s]);
+                mismatches++;
+            }
+        }
+
+        double adjacencySize = std::max<double>(1.0, static_cast<double>(graph.getAdjacencySize()));
+        std::cout << std::format("{:<22}{:>12.3f}{:>12.3f}{:>12.3f}{:>12.3f}\n", orderName,
+            lines / adjacencySize, pages / adjacencySize,
+            samples > 0 ? bfsTime / samples : 0.0, samples > 0 ? dijkstraTime / samples : 0.0);
+    }
+
+    graph.reorder(Graph::IndexOrder::ActorId);
+    std::cout << std::format("{} mismatches\n", mismatches);
+    std::cout << "============================\n\n";
+    return mismatches == 0;
+}
+
+//=====================================================================================
+//                              Loading Comparisons
+//=====================================================================================
+
+bool compareDatabaseLoad(SQLite::Database& db) {
+    std::cout << "\n=== Database Load ===\n";
+
+    // Doubling thread counts up to every core, every load must give the same graph
+    // At least 4 threads are run so the split between threads is checked on small machines too
+    std::vector<unsigned int> threadCounts = doublingThreadCounts(4);
+
+    std::vector<double> loadTime;
+    std::uint64_t baseFingerprint = 0;
+    int mismatches = 0;
+    for (unsigned int threads : threadCounts) {
+        auto startTime = std::chrono::high_resolution_clock::now();
+        Graph graph;
+        graph.loadFromDatabase(db, threads);
+        auto endTime = std::chrono::high_resolution_clock::now();
+        loadTime.push_back(std::chrono::duration<double, std::milli>(endTime - startTime).count());
+
+        if (threads == threadCounts.front()) {
+            baseFingerprint = graph.getFingerprint();
+        }
+        else if (graph.getFingerprint() != baseFingerprint) {
+            std::cerr << std::format("Database load with {} threads gave a different graph\n", threads);
+            mismatches++;
+        }
+    }
+
+    for (size_t i = 0; i < threadCounts.size(); i++) {
+        std::cout << std::format("{:<22}{:>12.3f} ms\n", std::format("{} Threads", threadCounts[i]), loadTime[i]);
+    }
+    std::cout << std::format("{} mismatches\n", mismatches);
+    std::cout << "============================\n\n";
+    return mismatches == 0;
+}
+
+//=====================================================================================
+//                          JSON Extraction
+//=====================================================================================
+
+bool compareJsonExtraction(const std::string& directory, int repeats) {
+    std::cout << "\n=== JSON Extraction ===\n";
+
+    std::vector<std::string> movieBodies;
+    std::vector<std::string> discoverBodies;
+    size_t movieBytes = 0;
+    size_t discoverBytes = 0;
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(directory, error)) {
+        if (!entry.is_regular_file() || entry.path().extension() != ".json") {
+            continue;
+        }
+        std::ifstream file(entry.path(), std::ios::binary);
+        std::stringstream contents;
+        contents << file.rdbuf();
+        if (entry.path().filename().string().starts_with("discover_")) {
+            discoverBytes += contents.str().size();
+            discoverBodies.push_back(contents.str());
+        }
+        else {
+            movieBytes += contents.str().size();
+            movieBodies.push_back(contents.str());
+        }
+    }
+    if (movieBodies.empty() && discoverBodies.empty()) {
+        std::cerr << std::format("No recorded responses in {}\n", directory);
+        std::cout << "============================\n\n";
+        return false;
+    }
+
+    // Milliseconds for repeats passes of extract over every body
+    auto timeExtraction = [&](const std::vector<std::string>& bodies, auto extract) {
+        auto startTime = std::chrono::high_resolution_clock::now();
+        for (int pass = 0; pass < repeats; pass++) {
+            for (const std::string& body : bodies) {
+                extract(body);
+            }
+        }
+        auto endTime = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration<double, std::milli>(endTime - startTime).count();
+    };
+
+    int mismatches = 0;
+    std::string message;
+    for (const std::string& body : movieBodies) {
+        MovieDetails dom;
+        MovieDetails sax;
+        bool domParsed = extractMovieDetailsDom(body, dom, message);
+        bool saxParsed = extractMovieDetails(body, sax, message);
+        if (domParsed != saxParsed || (domParsed && (dom.statusCode != sax.statusCode || dom.title != sax.title || dom.cast != sax.cast))) {
+            std::cerr << std::format("Movie extraction differs for \"{}\"\n", dom.title);
+            mismatches++;
+        }
+    }
+    for (const std::string& body : discoverBodies) {
+        std::vector<int> dom;
+        std::vector<int> sax;
+        if (extractDiscoverIdsDom(body, dom, message) != extractDiscoverIds(body, sax, message) || dom != sax) {
+            std::cerr << "Discover extraction differs\n";
+            mismatches++;
+        }
+    }
+
+    MovieDetails details;
+    std::vector<int> movieIDs;
+    double movieDomTime = timeExtraction(movieBodies, [&](const std::string& body) { extractMovieDetailsDom(body, details, message); });
+    double movieSaxTime = timeExtraction(movieBodies, [&](const std::string& body) { extractMovieDetails(body, details, message); });
+    double discoverDomTime = timeExtraction(discoverBodies, [&](const std::string& body) { extractDiscoverIdsDom(body, movieIDs, message); });
+    double discoverSaxTime = timeExtraction(discoverBodies, [&](const std::string& body) { extractDiscoverIds(body, movieIDs, message); });
+
+    // Throughput over the bytes handed in, including what the extractors could skip
+    auto megabytesPerSecond = [&](size_t bytes, double ms) {
+        return ms > 0.0 ? bytes * static_cast<double>(repeats) / (ms * 1000.0) : 0.0;
+    };
+    std::cout << std::format("{} movies ({} KiB), {} discover pages ({} KiB), {} passes\n",
+        movieBodies.size(), movieBytes / 1024, discoverBodies.size(), discoverBytes / 1024, repeats);
+    std::cout << std::format("{:<22}{:>12.3f} ms {:>10.1f} MB/s\n", "Movie DOM", movieDomTime, megabytesPerSecond(movieBytes, movieDomTime));
+    std::cout << std::format("{:<22}{:>12.3f} ms {:>10.1f} MB/s\n", "Movie SAX", movieSaxTime, megabytesPerSecond(movieBytes, movieSaxTime));
+    std::cout << std::format("{:<22}{:>12.3f} ms {:>10.1f} MB/s\n", "Discover DOM", discoverDomTime, megabytesPerSecond(discoverBytes, discoverDomTime));
+    std::cout << std::format("{:<22}{:>12.3f} ms {:>10.1f} MB/s\n", "Discover SAX", discoverSaxTime, megabytesPerSecond(discoverBytes, discoverSaxTime));
+    std::cout << std::format("{} mismatches\n", mismatches);
+    std::cout << "============================\n\n";
+    return mismatches == 0;
+}
@@ -0,0 +1,70 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include "graph.h"
+#include "bfh.h"
+#include "dijkstra.h"
+#include "landmarks.h"
+#include "contractionHierarchy.h"
+#include "tmdbParser.h"
+#include <vector>
+#include <string>
+#include <utility>
+
+//=====================================================================================
+//                          Benchmarks and Cross Checks
+//=====================================================================================
+// Developer tools, run from main on the real graph when changing the search code.
+// Each comparison runs random actor pairs through an existing implementation and a
+// faster one, checks that the answers agree, and prints the timings side by side.
+// They return true when every sampled query agreed.
+
+// Random (start, end) actor ID pairs, reproducible for a given seed
+std::vector<std::pair<int, int>> sampleActorPairs(const Graph& graph, int count, unsigned int seed = 42);
+
+// Thread counts doubling from 1 up to every core, ending on the core count (or minimumMax if more)
+std::vector<unsigned int> doublingThreadCounts(unsigned int minimumMax = 1);
+
+// Checks that a path result is a real path in the graph from startActorId to endActorId
+bool isValidPath(const Graph& graph, const PathResult& result, int startActorId, int endActorId);
+
+// BFS::findShortestPath vs the bidirectional and direction-optimizing modes (and distance tables)
+bool compareBFSModes(const Graph& graph, int samples = 200, unsigned int seed = 42);
+
+// Dijkstra::findStrongestPath on each priority queue type, and the bidirectional mode,
+// checked against the binary heap search
+// Paths may differ where several are equally strong, so the check is on total path cost
+bool compareDijkstraModes(const Graph& graph, int samples = 200, unsigned int seed = 42);
+
+// Dijkstra::computeCostTable vs delta-stepping on doubling thread counts (costs and parents)
+bool compareParallelCostTable(const Graph& graph, int samples = 10, unsigned int seed = 42);
+
+// Dijkstra::findStrongestPath vs the landmark guided A* search, checked by total path cost
+bool compareLandmarkSearch(const Graph& graph, const LandmarkIndex& landmarks, int samples = 200, unsigned int seed = 42);
+
+// Dijkstra::findStrongestPath vs the contraction hierarchy query, checked by total path cost
+bool compareContractionHierarchy(const Graph& graph, const ContractionHierarchy& hierarchy, int samples = 200, unsigned int seed = 42);
+
+// BFS::findShortestPath vs the hop label index (distances, and the rebuilt paths)
+bool compareHopLabels(const Graph& graph, const HopLabelIndex& labels, int samples = 200, unsigned int seed = 42);
+
+// BFS::computeDistanceTable vs the parallel BFS on doubling thread counts (distances, histograms and parents)
+bool compareParallelDistanceTable(const Graph& graph, int samples = 10, unsigned int seed = 42);
+
+// BFS::computeDistanceMatrix vs BFS::findShortestPath run on every (source, target) pair
+bool compareDistanceMatrix(const Graph& graph, int sourceCount = 64, int targetCount = 32, unsigned int seed = 42);
+
+// Every Graph::IndexOrder: how many cache lines and pages a sweep of the adjacency touches,
+// and BFS/Dijkstra table times, checked to give the same tables by actor ID
+// Reorders the graph it is given, and leaves it back in actor ID order
+bool compareIndexOrders(Graph& graph, int samples = 10, unsigned int seed = 42);
+
+// Graph::loadFromDatabase on doubling thread counts, checked to build the same graph (by fingerprint)
+// Pass the full merged database, that is the load the program falls back to without a snapshot
+bool compareDatabaseLoad(SQLite::Database& db);
+
+// extractMovieDetails/extractDiscoverIds vs their DOM versions, run repeats times over recorded
+// responses (see recordSampleResponses: discover_*.json files are discover pages, the rest movies)
+bool compareJsonExtraction(const std::string& directory, int repeats = 20);
+
+#endif // BENCHMARK_H
@@ -1,10 +1,13 @@
 ﻿#include "bfh.h"
-#include <queue>
-#include <unordered_map>
-#include <unordered_set>
 #include <iostream>
 #include <format>
 #include <algorithm>
+#include <bit>
+#include <atomic>
+#include <barrier>
+#include <thread>
+#include "bitmap.h"
+#include "queryWorkspace.h"
 
 //=====================================================================================
 //                          BFS Implementation
@@ -15,74 +18,47 @@ PathResult BFS::findShortestPath(const Graph& graph, int startActorId, int endAc
 
     PathResult result;
 
-    // Validate input
-    if (!graph.hasActor(startActorId)) {
-        std::cerr << std::format("Error: Start actor ID {} not found in graph.\n", startActorId);
-        return result;
-    }
-
-    if (!graph.hasActor(endActorId)) {
-        std::cerr << std::format("Error: End actor ID {} not found in graph.\n", endActorId);
-        return result;
-    }
-
-    // Special case: start and end are the same
-    if (startActorId == endActorId) {
-        result.path.push_back(startActorId);
-        const Actor* actor = graph.getActor(startActorId);
-        if (actor) {
-            result.actorNames.push_back(actor->name);
-        }
-        result.hopCount = 0;
-        result.totalWeight = 0;
-        result.pathExists = true;
-
-        auto endTime = std::chrono::high_resolution_clock::now();
-        result.executionTimeMs = std::chrono::duration<double, std::milli>(endTime - startTime).count();
-
+    int startIndex = -1;
+    int endIndex = -1;
+    if (resolvePathEnds(graph, startActorId, endActorId, startTime, result, startIndex, endIndex)) {
         return result;
     }
 
-    // BFS Algorithm
-    std::queue<int> queue;
-    std::unordered_set<int> visited;
-    std::unordered_map<int, int> parent;
+    // BFS Algorithm, on this thread's reusable workspace instead of fresh hash maps
+    QueryWorkspace& workspace = QueryWorkspace::forThread();
+    workspace.beginQuery(graph.getActorCount());
+    std::vector<int>& queue = workspace.queue; // Every actor is pushed at most once, so no ring buffer needed
+    size_t queueHead = 0;
+    QueryWorkspace::Stamps visited = workspace.stamps();
 
     // Initialize
-    queue.push(startActorId);
-    visited.insert(startActorId);
-    parent[startActorId] = -1; // Start node has no parent
+    queue.push_back(startIndex);
+    visited.markReached(startIndex);
+    workspace.parent[startIndex] = -1; // Start node has no parent
 
     bool found = false;
 
     // BFS traversal
-    while (!queue.empty() && !found) {
-        int currentActorId = queue.front();
-        queue.pop();
+    while (queueHead < queue.size() && !found) {
+        int currentIndex = queue[queueHead++];
 
         // Check if we reached the destination
-        if (currentActorId == endActorId) {
+        if (currentIndex == endIndex) {
             found = true;
             break;
         }
 
         // Explore all neighbors
-        const std::vector<Edge>* neighbors = graph.getNeighbors(currentActorId);
-        if (neighbors == nullptr) {
-            continue;
-        }
-
-        for (const Edge& edge : *neighbors) {
-            int neighborId = edge.targetActorId;
-
+        result.nodesExpanded++;
+        for (int neighborIndex : graph.getNeighborIndices(currentIndex)) {
             // If not visited, add to queue
-            if (visited.find(neighborId) == visited.end()) {
-                visited.insert(neighborId);
-                parent[neighborId] = currentActorId;
-                queue.push(neighborId);
+            if (!visited.isReached(neighborIndex)) {
+                visited.markReached(neighborIndex);
+                workspace.parent[neighborIndex] = currentIndex;
+                queue.push_back(neighborIndex);
 
                 // Early termination if we found the target
-                if (neighborId == endActorId) {
+                if (neighborIndex == endIndex) {
                     found = true;
                     break;
                 }
@@ -92,18 +68,626 @@ PathResult BFS::findShortestPath(const Graph& graph, int startActorId, int endAc
 
     // Reconstruct path if found
     if (found) {
-        result.path = reconstructPath(parent, startActorId, endActorId);
+        result.path = reconstructPath(graph, workspace.parent, startIndex, endIndex);
+        result.pathExists = true;
+        result.hopCount = static_cast<int>(result.path.size()) - 1;
+        result.totalWeight = calculatePathWeight(graph, result.path);
+
+        // Get actor names for the path
+        for (int actorId : result.path) {
+            result.actorNames.emplace_back(graph.getName(graph.getIndex(actorId)));
+        }
+    }
+    else {
+        std::cout << "No path found between the two actors.\n";
+    }
+
+    auto endTime = std::chrono::high_resolution_clock::now();
+    result.executionTimeMs = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+
+    return result;
+}
+
+PathResult BFS::findShortestPathBidirectional(const Graph& graph, int startActorId, int endActorId) {
+    auto startTime = std::chrono::high_resolution_clock::now();
+
+    PathResult result;
+
+    int startIndex = -1;
+    int endIndex = -1;
+    if (resolvePathEnds(graph, startActorId, endActorId, startTime, result, startIndex, endIndex)) {
+        return result;
+    }
+
+    // One search from each end, side 0 grows from the start and side 1 from the end
+    // Each side runs on its own workspace, hops is only valid where that side has reached
+    QueryWorkspace* side0 = &QueryWorkspace::forThread(0);
+    QueryWorkspace* side1 = &QueryWorkspace::forThread(1);
+    QueryWorkspace* sides[2] = { side0, side1 };
+    int roots[2] = { startIndex, endIndex };
+
+    for (int side = 0; side < 2; side++) {
+        sides[side]->beginQuery(graph.getActorCount());
+        sides[side]->stamps().markReached(roots[side]);
+        sides[side]->hops[roots[side]] = 0;
+        sides[side]->parent[roots[side]] = -1;
+        sides[side]->queue.push_back(roots[side]);
+    }
+
+    // Best meeting edge found so far (meetFrom is reached by side 0, meetTo by side 1)
+    int bestLength = -1;
+    int meetFrom = -1;
+    int meetTo = -1;
+
+    while (!side0->queue.empty() && !side1->queue.empty() && bestLength == -1) {
+        // Grow the smaller frontier by one full level
+        int side = side0->queue.size() <= side1->queue.size() ? 0 : 1;
+        QueryWorkspace& current = *sides[side];
+        const QueryWorkspace& other = *sides[1 - side];
+        QueryWorkspace::Stamps currentReached = sides[side]->stamps();
+        QueryWorkspace::Stamps otherReached = sides[1 - side]->stamps();
+        current.nextFrontier.clear();
+
+        for (int currentIndex : current.queue) {
+            result.nodesExpanded++;
+
+            for (int neighborIndex : graph.getNeighborIndices(currentIndex)) {
+                // Meeting the other search gives a candidate path, keep the shortest in this level
+                if (otherReached.isReached(neighborIndex)) {
+                    int length = current.hops[currentIndex] + 1 + other.hops[neighborIndex];
+                    if (bestLength == -1 || length < bestLength) {
+                        bestLength = length;
+                        meetFrom = side == 0 ? currentIndex : neighborIndex;
+                        meetTo = side == 0 ? neighborIndex : currentIndex;
+                    }
+                }
+
+                if (!currentReached.isReached(neighborIndex)) {
+                    currentReached.markReached(neighborIndex);
+                    current.hops[neighborIndex] = current.hops[currentIndex] + 1;
+                    current.parent[neighborIndex] = currentIndex;
+                    current.nextFrontier.push_back(neighborIndex);
+                }
+            }
+        }
+
+        current.queue.swap(current.nextFrontier);
+    }
+
+    // Reconstruct path if found, start -> meetFrom from side 0, then meetTo -> end from side 1
+    if (bestLength != -1) {
+        std::vector<int> path = reconstructPath(graph, side0->parent, startIndex, meetFrom);
+        for (int current = meetTo; current != -1; current = side1->parent[current]) {
+            path.push_back(graph.getActorId(current));
+            if (current == endIndex) {
+                break;
+            }
+        }
+
+        result.path = std::move(path);
         result.pathExists = true;
         result.hopCount = static_cast<int>(result.path.size()) - 1;
         result.totalWeight = calculatePathWeight(graph, result.path);
 
         // Get actor names for the path
         for (int actorId : result.path) {
-            const Actor* actor = graph.getActor(actorId);
-            if (actor) {
-                result.actorNames.push_back(actor->name);
+            result.actorNames.emplace_back(graph.getName(graph.getIndex(actorId)));
+        }
+    }
+    else {
+        std::cout << "No path found between the two actors.\n";
+    }
+
+    auto endTime = std::chrono::high_resolution_clock::now();
+    result.executionTimeMs = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+
+    return result;
+}
+
+//=====================================================================================
+//                          Direction-Optimizing BFS
+//=====================================================================================
+
+// Switch thresholds from Beamer et al.: go bottom-up once the frontier's edges exceed
+// 1/ALPHA of the unexplored edges, and back top-down once it holds under 1/BETA of the actors
+constexpr std::uint64_t DIRECTION_ALPHA = 14;
+constexpr std::uint64_t DIRECTION_BETA = 24;
+
+bool BFS::runDirectionOptimizing(const Graph& graph, int sourceIndex, int targetIndex, int& nodesExpanded) {
+    const size_t actorCount = graph.getActorCount();
+    QueryWorkspace& workspace = QueryWorkspace::forThread();
+    workspace.beginQuery(actorCount);
+
+    // The bitmaps double as the reached stamps here, so hops/parent are valid where visited is set
+    Bitmap& visited = workspace.visitedBits;
+    Bitmap& frontierBits = workspace.frontierBits;
+    Bitmap& nextBits = workspace.nextBits;
+    std::vector<int>& frontierList = workspace.queue;
+    std::vector<int>& nextList = workspace.nextFrontier;
+    std::vector<int>& parent = workspace.parent;
+    std::vector<int>& distance = workspace.hops;
+
+    visited.clear();
+    frontierList.push_back(sourceIndex);
+    visited.set(sourceIndex);
+    parent[sourceIndex] = -1;
+    distance[sourceIndex] = 0;
+
+    // Frontier size and the number of edges leaving it, plus edges not yet reached at all
+    size_t frontierSize = 1;
+    std::uint64_t frontierEdges = graph.getDegree(sourceIndex);
+    std::uint64_t unexploredEdges = graph.getAdjacencySize() - frontierEdges;
+    bool bottomUp = false;
+    int level = 0;
+
+    while (frontierSize > 0) {
+        if (targetIndex != -1 && visited.test(targetIndex)) {
+            return true;
+        }
+
+        // Pick the direction for this level, converting the frontier if it changes
+        if (!bottomUp && frontierEdges > unexploredEdges / DIRECTION_ALPHA) {
+            bottomUp = true;
+            frontierBits.clear();
+            for (int index : frontierList) {
+                frontierBits.set(index);
+            }
+        }
+        else if (bottomUp && frontierSize < actorCount / DIRECTION_BETA) {
+            bottomUp = false;
+            frontierList.clear();
+            frontierBits.forEachSet([&](size_t index) { frontierList.push_back(static_cast<int>(index)); });
+        }
+
+        level++;
+        size_t nextSize = 0;
+        std::uint64_t nextEdges = 0;
+
+        if (bottomUp) {
+            // Every unvisited actor looks for any neighbor in the frontier, stopping at the first one
+            nextBits.clear();
+            visited.forEachClear([&](size_t index) {
+                int currentIndex = static_cast<int>(index);
+                nodesExpanded++;
+                for (int neighborIndex : graph.getNeighborIndices(currentIndex)) {
+                    if (frontierBits.test(neighborIndex)) {
+                        parent[currentIndex] = neighborIndex;
+                        distance[currentIndex] = level;
+                        nextBits.set(currentIndex);
+                        nextSize++;
+                        nextEdges += graph.getDegree(currentIndex);
+                        break;
+                    }
+                }
+            });
+            visited.unionWith(nextBits);
+            frontierBits.swap(nextBits);
+        }
+        else {
+            // Classic step, the frontier pushes out to its unvisited neighbors
+            nextList.clear();
+            for (int currentIndex : frontierList) {
+                nodesExpanded++;
+                for (int neighborIndex : graph.getNeighborIndices(currentIndex)) {
+                    if (!visited.test(neighborIndex)) {
+                        visited.set(neighborIndex);
+                        parent[neighborIndex] = currentIndex;
+                        distance[neighborIndex] = level;
+                        nextList.push_back(neighborIndex);
+                        nextEdges += graph.getDegree(neighborIndex);
+                    }
+                }
+            }
+            nextSize = nextList.size();
+            frontierList.swap(nextList);
+        }
+
+        frontierSize = nextSize;
+        frontierEdges = nextEdges;
+        unexploredEdges -= std::min(unexploredEdges, nextEdges);
+    }
+
+    return targetIndex != -1 && visited.test(targetIndex);
+}
+
+PathResult BFS::findShortestPathDirectionOptimizing(const Graph& graph, int startActorId, int endActorId) {
+    auto startTime = std::chrono::high_resolution_clock::now();
+
+    PathResult result;
+
+    int startIndex = -1;
+    int endIndex = -1;
+    if (resolvePathEnds(graph, startActorId, endActorId, startTime, result, startIndex, endIndex)) {
+        return result;
+    }
+
+    bool found = runDirectionOptimizing(graph, startIndex, endIndex, result.nodesExpanded);
+
+    // Reconstruct path if found
+    if (found) {
+        result.path = reconstructPath(graph, QueryWorkspace::forThread().parent, startIndex, endIndex);
+        result.pathExists = true;
+        result.hopCount = static_cast<int>(result.path.size()) - 1;
+        result.totalWeight = calculatePathWeight(graph, result.path);
+
+        // Get actor names for the path
+        for (int actorId : result.path) {
+            result.actorNames.emplace_back(graph.getName(graph.getIndex(actorId)));
+        }
+    }
+    else {
+        std::cout << "No path found between the two actors.\n";
+    }
+
+    auto endTime = std::chrono::high_resolution_clock::now();
+    result.executionTimeMs = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+
+    return result;
+}
+
+DistanceTable BFS::computeDistanceTable(const Graph& graph, int startActorId) {
+    auto startTime = std::chrono::high_resolution_clock::now();
+
+    DistanceTable table;
+    table.sourceActorId = startActorId;
+
+    int startIndex = graph.getIndex(startActorId);
+    if (startIndex == -1) {
+        std::cerr << std::format("Error: Start actor ID {} not found in graph.\n", startActorId);
+        return table;
+    }
+
+    int nodesExpanded = 0;
+    runDirectionOptimizing(graph, startIndex, -1, nodesExpanded);
+
+    // Copy the reached part of the workspace out into the table
+    const QueryWorkspace& workspace = QueryWorkspace::forThread();
+    table.distance.assign(graph.getActorCount(), -1);
+    table.parent.assign(graph.getActorCount(), -1);
+    workspace.visitedBits.forEachSet([&](size_t index) {
+        table.distance[index] = workspace.hops[index];
+        table.parent[index] = workspace.parent[index];
+        table.reachableCount++;
+
+        if (table.histogram.size() <= static_cast<size_t>(workspace.hops[index])) {
+            table.histogram.resize(workspace.hops[index] + 1, 0);
+        }
+        table.histogram[workspace.hops[index]]++;
+    });
+
+    auto endTime = std::chrono::high_resolution_clock::now();
+    table.executionTimeMs = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+
+    return table;
+}
+
+DistanceTable BFS::computeDistanceTableParallel(const Graph& graph, int startActorId, unsigned int threadCount) {
+    auto startTime = std::chrono::high_resolution_clock::now();
+
+    // Frontier actors a thread takes at a time going top-down, small enough that a few well
+    // connected actors in one chunk don't leave the other threads waiting
+    constexpr size_t CHUNK_SIZE = 64;
+    // Actors a thread takes at a time going bottom-up
+    constexpr size_t BOTTOM_UP_CHUNK_SIZE = 4096;
+
+    DistanceTable table;
+    table.sourceActorId = startActorId;
+
+    int startIndex = graph.getIndex(startActorId);
+    if (startIndex == -1) {
+        std::cerr << std::format("Error: Start actor ID {} not found in graph.\n", startActorId);
+        return table;
+    }
+
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    // -1 in parent means unclaimed, so the source points at itself until the search is done
+    const size_t actorCount = graph.getActorCount();
+    table.distance.assign(actorCount, -1);
+    table.parent.assign(actorCount, -1);
+    table.distance[startIndex] = 0;
+    table.parent[startIndex] = startIndex;
+    table.histogram.push_back(1);
+
+    std::vector<int> frontier = { startIndex };
+    Bitmap frontierBits(actorCount);
+    std::vector<std::vector<int>> claimed(threadCount);
+    std::vector<std::uint64_t> claimedEdges(threadCount, 0);
+    std::vector<size_t> copyOffset(threadCount, 0);
+    std::atomic<size_t> nextChunk(0);
+    int level = 0;
+
+    // Same direction switches as runDirectionOptimizing: big levels go bottom-up, where every
+    // unreached actor looks for a parent in the frontier and only writes its own entries
+    std::uint64_t frontierEdges = graph.getDegree(startIndex);
+    std::uint64_t unexploredEdges = graph.getAdjacencySize() - frontierEdges;
+    bool bottomUp = false;
+
+    // Runs on one thread once all of them have finished a level: picks the next direction and
+    // lays out the next frontier
+    auto finishLevel = [&]() noexcept {
+        size_t total = 0;
+        std::uint64_t nextEdges = 0;
+        for (unsigned int t = 0; t < threadCount; t++) {
+            copyOffset[t] = total;
+            total += claimed[t].size();
+            nextEdges += claimedEdges[t];
+            claimedEdges[t] = 0;
+        }
+        frontier.resize(total);
+        if (total > 0) {
+            table.histogram.push_back(total);
+        }
+
+        frontierEdges = nextEdges;
+        unexploredEdges -= std::min(unexploredEdges, nextEdges);
+        if (!bottomUp && frontierEdges > unexploredEdges / DIRECTION_ALPHA) {
+            bottomUp = true;
+        }
+        else if (bottomUp && total < actorCount / DIRECTION_BETA) {
+            bottomUp = false;
+        }
+        if (bottomUp) {
+            frontierBits.clear();
+            for (const std::vector<int>& found : claimed) {
+                for (int index : found) {
+                    frontierBits.set(index);
+                }
+            }
+        }
+
+        nextChunk.store(0, std::memory_order_relaxed);
+        level++;
+    };
+    std::barrier expandDone(threadCount, finishLevel);
+    std::barrier copyDone(threadCount);
+
+    auto worker = [&](unsigned int t) {
+        std::vector<int>& mine = claimed[t];
+        std::uint64_t& mineEdges = claimedEdges[t];
+        while (!frontier.empty()) {
+            int nextLevel = level + 1;
+            if (bottomUp) {
+                for (size_t chunk = nextChunk.fetch_add(BOTTOM_UP_CHUNK_SIZE, std::memory_order_relaxed);
+                    chunk < actorCount;
+                    chunk = nextChunk.fetch_add(BOTTOM_UP_CHUNK_SIZE, std::memory_order_relaxed)) {
+                    size_t chunkEnd = std::min(chunk + BOTTOM_UP_CHUNK_SIZE, actorCount);
+                    for (size_t index = chunk; index < chunkEnd; index++) {
+                        // Nobody else writes this entry during a bottom-up level
+                        std::atomic_ref<int> parent(table.parent[index]);
+                        if (parent.load(std::memory_order_relaxed) != -1) {
+                            continue;
+                        }
+                        int current = static_cast<int>(index);
+                        for (int neighborIndex : graph.getNeighborIndices(current)) {
+                            if (frontierBits.test(neighborIndex)) {
+                                parent.store(neighborIndex, std::memory_order_relaxed);
+                                table.distance[index] = nextLevel;
+                                mine.push_back(current);
+                                mineEdges += graph.getDegree(current);
+                                break;
+                            }
+                        }
+                    }
+                }
+            }
+            else {
+                for (size_t chunk = nextChunk.fetch_add(CHUNK_SIZE, std::memory_order_relaxed);
+                    chunk < frontier.size();
+                    chunk = nextChunk.fetch_add(CHUNK_SIZE, std::memory_order_relaxed)) {
+                    size_t chunkEnd = std::min(chunk + CHUNK_SIZE, frontier.size());
+                    for (size_t i = chunk; i < chunkEnd; i++) {
+                        int current = frontier[i];
+                        for (int neighborIndex : graph.getNeighborIndices(current)) {
+                            // Load before the CAS, most neighbors were claimed long ago and needn't contend for the line
+                            std::atomic_ref<int> parent(table.parent[neighborIndex]);
+                            int unclaimed = -1;
+                            if (parent.load(std::memory_order_relaxed) == -1 &&
+                                parent.compare_exchange_strong(unclaimed, current, std::memory_order_relaxed)) {
+                                table.distance[neighborIndex] = nextLevel;
+                                mine.push_back(neighborIndex);
+                                mineEdges += graph.getDegree(neighborIndex);
+                            }
+                        }
+                    }
+                }
             }
+            expandDone.arrive_and_wait();
+
+            std::copy(mine.begin(), mine.end(), frontier.begin() + copyOffset[t]);
+            mine.clear();
+            copyDone.arrive_and_wait();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned int t = 1; t < threadCount; t++) {
+        threads.emplace_back(worker, t);
+    }
+    worker(0);
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    table.parent[startIndex] = -1;
+    for (size_t count : table.histogram) {
+        table.reachableCount += count;
+    }
+
+    auto endTime = std::chrono::high_resolution_clock::now();
+    table.executionTimeMs = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+
+    return table;
+}
+
+//=====================================================================================
+//                          Multi-Source BFS
+//=====================================================================================
+
+DistanceMatrix BFS::computeDistanceMatrix(
+    const Graph& graph,
+    const std::vector<int>& sourceActorIds,
+    const std::vector<int>& targetActorIds
+) {
+    auto startTime = std::chrono::high_resolution_clock::now();
+
+    // One bit per source of a batch
+    constexpr size_t BATCH_SIZE = 64;
+
+    DistanceMatrix matrix;
+    matrix.sourceActorIds = sourceActorIds;
+    matrix.targetActorIds = targetActorIds;
+    matrix.distance.assign(sourceActorIds.size() * targetActorIds.size(), -1);
+
+    // Each distinct target actor gets a slot, an actor listed twice shares it between both columns
+    // Only the slots in a source's own component can ever be reached from it
+    size_t actorCount = graph.getActorCount();
+    std::vector<int> slotOf(actorCount, -1);
+    std::vector<int> columnSlot(targetActorIds.size(), -1);
+    std::vector<size_t> componentSlots(graph.getComponentCount(), 0);
+    int slotCount = 0;
+    for (size_t column = 0; column < targetActorIds.size(); column++) {
+        int index = graph.getIndex(targetActorIds[column]);
+        if (index == -1) {
+            std::cerr << std::format("Error: Target actor ID {} not found in graph.\n", targetActorIds[column]);
+            continue;
         }
+        if (slotOf[index] == -1) {
+            slotOf[index] = slotCount++;
+            componentSlots[graph.getComponent(index)]++;
+        }
+        columnSlot[column] = slotOf[index];
+    }
+
+    // Per actor masks: which sources have seen it, which reached it on the current level,
+    // and which reach it on the next one
+    std::vector<std::uint64_t> seen(actorCount);
+    std::vector<std::uint64_t> visit(actorCount, 0);
+    std::vector<std::uint64_t> visitNext(actorCount, 0);
+    std::vector<int> frontier;
+    std::vector<int> nextFrontier;
+    std::vector<int> slotDistance;
+
+    for (size_t batchStart = 0; batchStart < sourceActorIds.size(); batchStart += BATCH_SIZE) {
+        size_t batchSize = std::min(BATCH_SIZE, sourceActorIds.size() - batchStart);
+        std::fill(seen.begin(), seen.end(), 0);
+        slotDistance.assign(batchSize * slotCount, -1);
+        frontier.clear();
+
+        // (source, target) pairs of this batch still without a distance, unreachable pairs
+        // aren't counted so a batch can stop without exhausting its components
+        size_t pending = 0;
+        for (size_t lane = 0; lane < batchSize; lane++) {
+            int index = graph.getIndex(sourceActorIds[batchStart + lane]);
+            if (index == -1) {
+                std::cerr << std::format("Error: Source actor ID {} not found in graph.\n", sourceActorIds[batchStart + lane]);
+                continue;
+            }
+            if (visit[index] == 0) {
+                frontier.push_back(index);
+            }
+            seen[index] |= std::uint64_t(1) << lane;
+            visit[index] |= std::uint64_t(1) << lane;
+            pending += componentSlots[graph.getComponent(index)];
+            if (slotOf[index] != -1) {
+                slotDistance[lane * slotCount + slotOf[index]] = 0;
+                pending--;
+            }
+        }
+
+        int level = 0;
+        while (!frontier.empty() && pending > 0) {
+            level++;
+
+            // Every actor on the frontier passes on the sources that reached it, to the neighbors
+            // those sources haven't seen yet
+            nextFrontier.clear();
+            for (int current : frontier) {
+                std::uint64_t sources = visit[current];
+                for (int neighborIndex : graph.getNeighborIndices(current)) {
+                    std::uint64_t newSources = sources & ~seen[neighborIndex];
+                    if (newSources != 0) {
+                        if (visitNext[neighborIndex] == 0) {
+                            nextFrontier.push_back(neighborIndex);
+                        }
+                        visitNext[neighborIndex] |= newSources;
+                    }
+                }
+                visit[current] = 0;
+            }
+
+            // Only now mark them seen, so every source reaching an actor on this level gets through
+            for (int index : nextFrontier) {
+                std::uint64_t newSources = visitNext[index];
+                visitNext[index] = 0;
+                seen[index] |= newSources;
+                visit[index] = newSources;
+
+                if (slotOf[index] != -1) {
+                    for (std::uint64_t bits = newSources; bits != 0; bits &= bits - 1) {
+                        int lane = std::countr_zero(bits);
+                        slotDistance[lane * slotCount + slotOf[index]] = level;
+                        pending--;
+                    }
+                }
+            }
+            std::swap(frontier, nextFrontier);
+        }
+
+        // Stopped early, so the last frontier still holds its masks
+        for (int index : frontier) {
+            visit[index] = 0;
+        }
+
+        for (size_t lane = 0; lane < batchSize; lane++) {
+            for (size_t column = 0; column < targetActorIds.size(); column++) {
+                if (columnSlot[column] != -1) {
+                    matrix.distance[(batchStart + lane) * targetActorIds.size() + column] =
+                        slotDistance[lane * slotCount + columnSlot[column]];
+                }
+            }
+        }
+    }
+
+    auto endTime = std::chrono::high_resolution_clock::now();
+    matrix.executionTimeMs = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+
+    return matrix;
+}
+
+//=====================================================================================
+//                          Hop Label Queries
+//=====================================================================================
+
+PathResult BFS::findShortestPathLabeled(const Graph& graph, const HopLabelIndex& labels, int startActorId, int endActorId) {
+    if (!labels.matches(graph)) {
+        std::cerr << "Warning: Hop labels were not built for this graph, using bidirectional BFS instead.\n";
+        return findShortestPathBidirectional(graph, startActorId, endActorId);
+    }
+
+    auto startTime = std::chrono::high_resolution_clock::now();
+
+    PathResult result;
+
+    int startIndex = -1;
+    int endIndex = -1;
+    if (resolvePathEnds(graph, startActorId, endActorId, startTime, result, startIndex, endIndex)) {
+        return result;
+    }
+
+    // The labels give the path directly, nothing is expanded
+    std::vector<int> indexPath = labels.queryPath(startIndex, endIndex);
+
+    if (!indexPath.empty()) {
+        for (int index : indexPath) {
+            result.path.push_back(graph.getActorId(index));
+            result.actorNames.emplace_back(graph.getName(index));
+        }
+        result.pathExists = true;
+        result.hopCount = static_cast<int>(result.path.size()) - 1;
+        result.totalWeight = calculatePathWeight(graph, result.path);
     }
     else {
         std::cout << "No path found between the two actors.\n";
@@ -115,28 +699,93 @@ PathResult BFS::findShortestPath(const Graph& graph, int startActorId, int endAc
     return result;
 }
 
+int BFS::getDegreesOfSeparation(const Graph& graph, const HopLabelIndex& labels, int startActorId, int endActorId) {
+    if (!labels.matches(graph)) {
+        std::cerr << "Warning: Hop labels were not built for this graph, using bidirectional BFS instead.\n";
+        PathResult result = findShortestPathBidirectional(graph, startActorId, endActorId);
+        return result.pathExists ? result.hopCount : -1;
+    }
+
+    int startIndex = graph.getIndex(startActorId);
+    int endIndex = graph.getIndex(endActorId);
+    if (startIndex == -1 || endIndex == -1) {
+        return -1;
+    }
+    return labels.queryDistance(startIndex, endIndex);
+}
+
 //=====================================================================================
 //                          Helper Methods
 //=====================================================================================
 
-std::vector<int> BFS::reconstructPath(
-    const std::unordered_map<int, int>& parent,
+bool resolvePathEnds(
+    const Graph& graph,
     int startActorId,
-    int endActorId
+    int endActorId,
+    std::chrono::high_resolution_clock::time_point startTime,
+    PathResult& result,
+    int& startIndex,
+    int& endIndex
+) {
+    startIndex = graph.getIndex(startActorId);
+    endIndex = graph.getIndex(endActorId);
+
+    if (startIndex == -1) {
+        std::cerr << std::format("Error: Start actor ID {} not found in graph.\n", startActorId);
+        return true;
+    }
+
+    if (endIndex == -1) {
+        std::cerr << std::format("Error: End actor ID {} not found in graph.\n", endActorId);
+        return true;
+    }
+
+    // Actors in different components have no path, no need to search the whole component to find out
+    if (!graph.areConnected(startIndex, endIndex)) {
+        std::cout << "No path found between the two actors.\n";
+        return true;
+    }
+
+    // Special case: start and end are the same
+    if (startActorId == endActorId) {
+        result.path.push_back(startActorId);
+        result.actorNames.emplace_back(graph.getName(startIndex));
+        result.hopCount = 0;
+        result.totalWeight = 0;
+        result.pathExists = true;
+
+        auto endTime = std::chrono::high_resolution_clock::now();
+        result.executionTimeMs = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+        return true;
+    }
+
+    return false;
+}
+
+std::vector<std::pair<int, int>> pathHops(const Graph& graph, const std::vector<int>& path) {
+    std::vector<std::pair<int, int>> hops;
+    for (size_t i = 0; i + 1 < path.size(); i++) {
+        hops.emplace_back(graph.getIndex(path[i]), graph.getIndex(path[i + 1]));
+    }
+    return hops;
+}
+
+std::vector<int> BFS::reconstructPath(
+    const Graph& graph,
+    const std::vector<int>& parent,
+    int startIndex,
+    int endIndex
 ) {
     std::vector<int> path;
-    int current = endActorId;
+    int current = endIndex;
 
     // Trace back from end to start
     while (current != -1) {
-        path.push_back(current);
-        auto it = parent.find(current);
-        if (it != parent.end()) {
-            current = it->second;
-        }
-        else {
+        path.push_back(graph.getActorId(current));
+        if (current == startIndex) {
             break;
         }
+        current = parent[current];
     }
 
     // Reverse to get path from start to end
@@ -148,8 +797,7 @@ std::vector<int> BFS::reconstructPath(
 int BFS::calculatePathWeight(const Graph& graph, const std::vector<int>& path) {
     int totalWeight = 0;
 
-    for (size_t i = 0; i < path.size() - 1; i++) {
-        int weight = graph.getEdgeWeight(path[i], path[i + 1]);
+    for (int weight : graph.getEdgeWeights(pathHops(graph, path))) {
         totalWeight += weight;
     }
 
@@ -168,6 +816,7 @@ void BFS::printPath(const PathResult& result) {
     std::cout << std::format("Path Length: {} degrees of separation\n", result.hopCount);
     std::cout << std::format("Total Collaboration Weight: {}\n", result.totalWeight);
     std::cout << std::format("Execution Time: {:.3f} ms\n", result.executionTimeMs);
+    std::cout << std::format("Actors Expanded: {}\n", result.nodesExpanded);
     std::cout << "\nPath:\n";
 
     for (size_t i = 0; i < result.actorNames.size(); i++) {
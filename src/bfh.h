@@ -2,9 +2,10 @@
 #define BFH_H
 
 #include "graph.h"
+#include "hopLabels.h"
 #include <vector>
+#include <string_view>
 #include <chrono>
-#include <unordered_map>
 
 //=====================================================================================
 //                          Path Result Structure
@@ -12,14 +13,71 @@
 // Stores the result of a pathfinding operation
 struct PathResult {
     std::vector<int> path;              // Sequence of actor IDs from start to end
-    std::vector<std::string> actorNames; // Names corresponding to the path
+    std::vector<std::string_view> actorNames; // Names along the path, they point into the graph's name
+                                              // storage, so copy them to keep them past the graph
     int hopCount;                        // Number of hops (edges) in the path
     int totalWeight;                     // Sum of edge weights along the path
     double executionTimeMs;              // Time taken to find the path (milliseconds)
+    int nodesExpanded;                   // Number of actors whose neighbors were scanned
     bool pathExists;                     // Whether a path was found
 
     PathResult()
-        : hopCount(0), totalWeight(0), executionTimeMs(0.0), pathExists(false) {
+        : hopCount(0), totalWeight(0), executionTimeMs(0.0), nodesExpanded(0), pathExists(false) {
+    }
+};
+
+// The start every path query shares: looks both actors up and answers right away when no search
+// is needed (an actor missing from the graph, the two in different components, or start == end)
+// Returns true if result is already the answer, otherwise the search runs from startIndex to endIndex
+bool resolvePathEnds(
+    const Graph& graph,
+    int startActorId,
+    int endActorId,
+    std::chrono::high_resolution_clock::time_point startTime,
+    PathResult& result,
+    int& startIndex,
+    int& endIndex
+);
+
+// The (index, index) pair of every hop along a path of actor IDs, for Graph::getEdgeWeights
+std::vector<std::pair<int, int>> pathHops(const Graph& graph, const std::vector<int>& path);
+
+//=====================================================================================
+//                          Distance Table Structure
+//=====================================================================================
+// Hop distances from one actor to every actor in the graph (its "Bacon numbers")
+// Both arrays are indexed by dense graph index
+struct DistanceTable {
+    int sourceActorId;
+    std::vector<int> distance;           // Hops from the source, -1 if unreachable
+    std::vector<int> parent;             // Previous index on a shortest path, -1 for the source/unreachable
+    std::vector<size_t> histogram;       // Actors at each hop distance, histogram[0] is the source itself
+    size_t reachableCount;               // Actors reached, including the source
+    double executionTimeMs;              // Time taken to build the table (milliseconds)
+
+    DistanceTable()
+        : sourceActorId(-1), reachableCount(0), executionTimeMs(0.0) {
+    }
+};
+
+//=====================================================================================
+//                          Distance Matrix Structure
+//=====================================================================================
+// Hop distances from each of a list of source actors to each of a list of target actors
+// distance is row-major, one row per source: distance[row * targetActorIds.size() + column]
+struct DistanceMatrix {
+    std::vector<int> sourceActorIds;
+    std::vector<int> targetActorIds;
+    std::vector<int> distance;           // Hops between the two, -1 if unreachable (or either actor is missing)
+    double executionTimeMs;              // Time taken to fill the matrix (milliseconds)
+
+    DistanceMatrix()
+        : executionTimeMs(0.0) {
+    }
+
+    // Hops from sourceActorIds[row] to targetActorIds[column]
+    int getDistance(size_t row, size_t column) const {
+        return distance[row * targetActorIds.size() + column];
     }
 };
 
@@ -28,21 +86,72 @@ struct PathResult {
 //=====================================================================================
 // Implements Breadth-First Search to find shortest path by hop count
 // (Ignores edge weights - finds path with fewest intermediate actors)
+// Runs on the dense CSR indices of the graph, IDs are only used for input and output
 class BFS {
 public:
     // Find shortest path from startActorId to endActorId
     // Returns PathResult with the path information
     static PathResult findShortestPath(const Graph& graph, int startActorId, int endActorId);
 
+    // Same query, but searching from both actors at once, a level at a time from whichever
+    // side has the smaller frontier, stopping when the two searches meet.
+    // Returns a path with the same hop count, while expanding far fewer actors on large graphs
+    static PathResult findShortestPathBidirectional(const Graph& graph, int startActorId, int endActorId);
+
+    // Same query using direction-optimizing BFS (Beamer et al.) with bitmap visited/frontier sets
+    // Levels are expanded top-down while the frontier is small, and bottom-up (every unvisited
+    // actor looks for a parent in the frontier) once the frontier touches most remaining edges.
+    // Best for far apart or unconnected actors, where a search ends up covering most of the graph
+    static PathResult findShortestPathDirectionOptimizing(const Graph& graph, int startActorId, int endActorId);
+
+    // Same query answered from the hop label index (see hopLabels.h) instead of searching
+    // Falls back to findShortestPathBidirectional if the labels weren't built for this graph
+    static PathResult findShortestPathLabeled(const Graph& graph, const HopLabelIndex& labels, int startActorId, int endActorId);
+
+    // Just the hop distance between two actors from the hop label index, -1 if not connected
+    // (or either actor is missing), with no path to rebuild it takes about a microsecond
+    // Falls back to findShortestPathBidirectional too if the labels weren't built for this graph
+    static int getDegreesOfSeparation(const Graph& graph, const HopLabelIndex& labels, int startActorId, int endActorId);
+
+    // Hop distances from one actor to every other actor, using the direction-optimizing engine
+    static DistanceTable computeDistanceTable(const Graph& graph, int startActorId);
+
+    // Same table from a level-synchronous BFS spread over threadCount threads (0 uses every core)
+    // Each level's frontier is split into chunks that the threads take in turn. A thread claims
+    // an unreached neighbor with a compare-and-swap on its parent entry, so every actor is
+    // claimed exactly once, and collects its claims in its own buffer. The buffers are then
+    // copied side by side into the next frontier, each thread writing its own range.
+    // Levels big enough for runDirectionOptimizing to go bottom-up do so here too, split by actor index.
+    // Distances match computeDistanceTable, parents may differ where there are several shortest paths
+    static DistanceTable computeDistanceTableParallel(const Graph& graph, int startActorId, unsigned int threadCount = 0);
+
+    // Hop distances between every source and every target, for batches like one actor
+    // against a whole cast list. Runs a multi-source BFS (Then et al.): up to 64 sources
+    // share one traversal, each actor holding a 64 bit mask of the sources that reached it,
+    // so every adjacency list is scanned once per level for the whole batch instead of once
+    // per source. A batch stops as soon as all of its sources have reached every target.
+    static DistanceMatrix computeDistanceMatrix(
+        const Graph& graph,
+        const std::vector<int>& sourceActorIds,
+        const std::vector<int>& targetActorIds
+    );
+
     // Helper method to print the path nicely
     static void printPath(const PathResult& result);
 
 private:
-    // Reconstruct the path from parent map
+    // Direction-optimizing BFS from sourceIndex, on this thread's workspace (slot 0)
+    // Afterwards visitedBits marks the reached actors, with their parent and hops filled in
+    // Stops after the level that reaches targetIndex, or runs over the whole component if it's -1
+    // Returns whether targetIndex was reached
+    static bool runDirectionOptimizing(const Graph& graph, int sourceIndex, int targetIndex, int& nodesExpanded);
+
+    // Reconstruct the path (as actor IDs) from the dense parent array
     static std::vector<int> reconstructPath(
-        const std::unordered_map<int, int>& parent,
-        int startActorId,
-        int endActorId
+        const Graph& graph,
+        const std::vector<int>& parent,
+        int startIndex,
+        int endIndex
     );
 
     // Calculate total weight of a path
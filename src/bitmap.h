@@ -0,0 +1,102 @@
+#ifndef BITMAP_H
+#define BITMAP_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <bit>
+
+//=====================================================================================
+//                              Bitmap Class
+//=====================================================================================
+// Fixed size set of dense graph indices, one bit per actor packed into 64 bit words
+// Used for BFS visited/frontier sets: an actor costs 1 bit instead of a hash set entry,
+// and whole words can be tested, merged and skipped at once.
+class Bitmap {
+public:
+    Bitmap() : bitCount(0) {}
+    explicit Bitmap(size_t size) : words((size + 63) / 64, 0), bitCount(size) {}
+
+    // Resize to hold size bits, all cleared
+    void assign(size_t size) {
+        words.assign((size + 63) / 64, 0);
+        bitCount = size;
+    }
+
+    void set(size_t index) {
+        words[index >> 6] |= std::uint64_t(1) << (index & 63);
+    }
+
+    void reset(size_t index) {
+        words[index >> 6] &= ~(std::uint64_t(1) << (index & 63));
+    }
+
+    bool test(size_t index) const {
+        return (words[index >> 6] >> (index & 63)) & 1;
+    }
+
+    // Clear every bit, a word at a time
+    void clear() {
+        std::fill(words.begin(), words.end(), 0);
+    }
+
+    // this |= other, a word at a time
+    void unionWith(const Bitmap& other) {
+        for (size_t w = 0; w < words.size(); w++) {
+            words[w] |= other.words[w];
+        }
+    }
+
+    // Number of set bits
+    size_t count() const {
+        size_t total = 0;
+        for (std::uint64_t word : words) {
+            total += std::popcount(word);
+        }
+        return total;
+    }
+
+    // Call visit(index) for every set bit, skipping empty words entirely
+    template <typename Visitor>
+    void forEachSet(Visitor&& visit) const {
+        for (size_t w = 0; w < words.size(); w++) {
+            std::uint64_t word = words[w];
+            while (word != 0) {
+                visit(w * 64 + std::countr_zero(word));
+                word &= word - 1;
+            }
+        }
+    }
+
+    // Call visit(index) for every clear bit below size(), skipping full words entirely
+    template <typename Visitor>
+    void forEachClear(Visitor&& visit) const {
+        for (size_t w = 0; w < words.size(); w++) {
+            std::uint64_t word = ~words[w];
+            while (word != 0) {
+                size_t index = w * 64 + std::countr_zero(word);
+                if (index >= bitCount) {
+                    return;
+                }
+                visit(index);
+                word &= word - 1;
+            }
+        }
+    }
+
+    size_t size() const {
+        return bitCount;
+    }
+
+    void swap(Bitmap& other) {
+        words.swap(other.words);
+        std::swap(bitCount, other.bitCount);
+    }
+
+private:
+    std::vector<std::uint64_t> words;
+    size_t bitCount;
+};
+
+#endif // BITMAP_H
@@ -0,0 +1,103 @@
+#ifndef BOUNDEDQUEUE_H
+#define BOUNDEDQUEUE_H
+
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <optional>
+#include <chrono>
+#include <cstddef>
+#include <algorithm>
+
+//=====================================================================================
+//                              BoundedQueue Class
+//=====================================================================================
+// Thread-safe FIFO queue holding at most capacity items, used to hand work between stages
+// Pushing into a full queue blocks, so a slow stage holds back the one feeding it instead
+// of letting work pile up in memory. Once closed, pushes are refused and pops drain what's left.
+template <typename T>
+class BoundedQueue {
+public:
+    explicit BoundedQueue(size_t capacity) : capacity(std::max<size_t>(1, capacity)), closed(false) {}
+
+    // Add an item, waiting while the queue is full, returns false (dropping it) if the queue was closed
+    bool push(T item) {
+        std::unique_lock<std::mutex> lock(mutex);
+        notFull.wait(lock, [&]() { return items.size() < capacity || closed; });
+        if (closed) {
+            return false;
+        }
+        items.push_back(std::move(item));
+        lock.unlock();
+        notEmpty.notify_one();
+        return true;
+    }
+
+    // Take the oldest item, waiting while the queue is empty, nullopt once it is closed and drained
+    std::optional<T> pop() {
+        std::unique_lock<std::mutex> lock(mutex);
+        notEmpty.wait(lock, [&]() { return !items.empty() || closed; });
+        return takeFront(lock);
+    }
+
+    // Same, but giving up at deadline (nullopt then too, check isDrained() to tell the two apart)
+    template <typename Clock, typename Duration>
+    std::optional<T> popUntil(const std::chrono::time_point<Clock, Duration>& deadline) {
+        std::unique_lock<std::mutex> lock(mutex);
+        notEmpty.wait_until(lock, deadline, [&]() { return !items.empty() || closed; });
+        return takeFront(lock);
+    }
+
+    // Take the oldest item only if one is waiting
+    std::optional<T> tryPop() {
+        std::unique_lock<std::mutex> lock(mutex);
+        return takeFront(lock);
+    }
+
+    // No more items will be pushed, wakes everything waiting on the queue
+    void close() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            closed = true;
+        }
+        notEmpty.notify_all();
+        notFull.notify_all();
+    }
+
+    // Closed and empty, so pops will never return an item again
+    bool isDrained() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return closed && items.empty();
+    }
+
+    size_t size() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return items.size();
+    }
+
+    size_t getCapacity() const {
+        return capacity;
+    }
+
+private:
+    mutable std::mutex mutex;
+    std::condition_variable notEmpty;
+    std::condition_variable notFull;
+    std::deque<T> items;
+    size_t capacity;
+    bool closed;
+
+    // Pop the front item if there is one (caller holds the lock, which is released before notifying)
+    std::optional<T> takeFront(std::unique_lock<std::mutex>& lock) {
+        if (items.empty()) {
+            return std::nullopt;
+        }
+        T item = std::move(items.front());
+        items.pop_front();
+        lock.unlock();
+        notFull.notify_one();
+        return item;
+    }
+};
+
+#endif // BOUNDEDQUEUE_H
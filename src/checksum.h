@@ -0,0 +1,164 @@
+#ifndef CHECKSUM_H
+#define CHECKSUM_H
+
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <initializer_list>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+//=====================================================================================
+//                              File Checksums
+//=====================================================================================
+// Shared by the binary files written next to the database (graph snapshot, landmarks, hop labels...)
+
+// Starting value for updateChecksum()
+constexpr std::uint64_t CHECKSUM_SEED = 14695981039346656037ULL;
+
+// FNV-1a style hash, but over 8 byte words so checking a big file stays cheap
+// A trailing partial word is hashed as if zero padded, matching the padding in the files
+inline void updateChecksum(std::uint64_t& hash, const void* data, std::uint64_t size) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    std::uint64_t word = 0;
+    std::uint64_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        std::memcpy(&word, bytes + i, 8);
+        hash = (hash ^ word) * 1099511628211ULL;
+    }
+    if (i < size) {
+        word = 0;
+        std::memcpy(&word, bytes + i, size - i);
+        hash = (hash ^ word) * 1099511628211ULL;
+    }
+}
+
+//=====================================================================================
+//                              File Sections
+//=====================================================================================
+// Index files store each array as its own section, zero padded to 8 bytes so the next one
+// stays aligned, and hash every section into one payload checksum as they go
+
+// Size of a section on disk, padding included
+inline std::uint64_t sectionSize(std::uint64_t size) {
+    return (size + 7) & ~std::uint64_t(7);
+}
+
+// Writes one section and its zero padding, hashing both
+inline void writeSection(std::ofstream& file, std::uint64_t& checksum, const void* data, std::uint64_t size) {
+    const char padding[8] = {};
+    file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+    file.write(padding, static_cast<std::streamsize>(sectionSize(size) - size));
+    updateChecksum(checksum, data, size);
+}
+
+// Reads one section of count elements into a vector, skipping its padding
+template <typename T>
+void readSection(std::ifstream& file, std::uint64_t& checksum, std::vector<T>& data, std::uint64_t count) {
+    std::uint64_t size = count * sizeof(T);
+    char padding[8];
+    data.resize(count);
+    file.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(size));
+    file.read(padding, static_cast<std::streamsize>(sectionSize(size) - size));
+    updateChecksum(checksum, data.data(), size);
+}
+
+//=====================================================================================
+//                              File Framing
+//=====================================================================================
+// Every file starts with a header holding magic[8], version and headerSize, and ends it with
+// payloadChecksum over the sections after it. These write and check that framing the same way
+// for all of them. description names the file in messages ("Hop label file", "hop labels").
+
+// Fills in the header's magic, version and size, then writes it and the sections to a temporary
+// file first, so a crash never leaves a half written file behind. writeSections(file, checksum)
+// writes everything after the header. The checksum is only known at the end, so the header is
+// written twice before the file is renamed into place.
+template <typename Header, typename WriteSections>
+bool writeFramedFile(const std::string& path, std::string_view description, const char (&magic)[8],
+    std::uint32_t version, Header& header, WriteSections writeSections) {
+    std::memcpy(header.magic, magic, sizeof(header.magic));
+    header.version = version;
+    header.headerSize = sizeof(Header);
+
+    std::string tempPath = path + ".tmp";
+    try {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            std::cerr << std::format("Error: Could not open {} for writing.\n", tempPath);
+            return false;
+        }
+
+        std::uint64_t checksum = CHECKSUM_SEED;
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        writeSections(file, checksum);
+
+        header.payloadChecksum = checksum;
+        file.seekp(0);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+        file.close();
+        if (!file) {
+            std::cerr << std::format("Error: Failed while writing {} {}.\n", description, tempPath);
+            return false;
+        }
+
+        std::filesystem::rename(tempPath, path);
+    }
+    catch (const std::exception& e) {
+        std::cerr << std::format("Error saving {}: {}\n", description, e.what());
+        return false;
+    }
+    return true;
+}
+
+// Copies the header out of the first size bytes of a file and checks its magic, version and size,
+// so none of the sizes in it are trusted before then. Warns and returns false if any are off.
+template <typename Header>
+bool readFileHeader(const void* data, std::uint64_t size, const std::string& path, std::string_view description,
+    const char (&magic)[8], std::uint32_t version, Header& header) {
+    if (size < sizeof(Header)) {
+        std::cerr << std::format("Warning: {} {} is truncated, ignoring it.\n", description, path);
+        return false;
+    }
+    std::memcpy(&header, data, sizeof(Header));
+
+    if (std::memcmp(header.magic, magic, sizeof(header.magic)) != 0 ||
+        header.version != version || header.headerSize != sizeof(Header)) {
+        std::cerr << std::format("Warning: {} {} has an unknown format or version, ignoring it.\n", description, path);
+        return false;
+    }
+    return true;
+}
+
+// The same, reading the header from the start of an open file
+template <typename Header>
+bool readFileHeader(std::ifstream& file, const std::string& path, std::string_view description,
+    const char (&magic)[8], std::uint32_t version, Header& header) {
+    char raw[sizeof(Header)];
+    file.read(raw, sizeof(raw));
+    return readFileHeader(raw, static_cast<std::uint64_t>(file.gcount()), path, description, magic, version, header);
+}
+
+// The file must be exactly the header plus these sections (sizes without padding),
+// checked before anything is allocated from the header's counts
+template <typename Header>
+bool checkFileLayout(const std::string& path, std::string_view description, std::initializer_list<std::uint64_t> sectionSizes) {
+    std::uint64_t expectedSize = sizeof(Header);
+    for (std::uint64_t size : sectionSizes) {
+        expectedSize += sectionSize(size);
+    }
+    std::error_code error;
+    if (std::filesystem::file_size(path, error) != expectedSize || error) {
+        std::cerr << std::format("Warning: {} {} has a corrupt layout, ignoring it.\n", description, path);
+        return false;
+    }
+    return true;
+}
+
+#endif // CHECKSUM_H
@@ -0,0 +1,216 @@
+#include "collectionPipeline.h"
+#include <iostream>
+#include <format>
+#include <thread>
+#include <vector>
+#include <string>
+#include <algorithm>
+
+//=====================================================================================
+//                          Constructor
+//=====================================================================================
+
+CollectionPipeline::CollectionPipeline(SQLite::Database& db, RateLimiter& limiter, const Options& options)
+    : db(db), limiter(limiter), options(options),
+    movieIds(options.queueCapacity), responses(options.queueCapacity), movies(options.queueCapacity),
+    pagesFetched(0), moviesFetched(0), moviesParsed(0), moviesWritten(0), creditsWritten(0), transactions(0),
+    startTime(std::chrono::steady_clock::now()), finished(false) {
+}
+
+//=====================================================================================
+//                          Running
+//=====================================================================================
+
+CollectionPipeline::Stats CollectionPipeline::run(int year) {
+    startTime = std::chrono::steady_clock::now();
+    int fetchWorkers = std::max(1, options.fetchWorkers);
+    int parseWorkers = std::max(1, options.parseWorkers);
+    std::atomic<int> fetchersLeft(fetchWorkers);
+    std::atomic<int> parsersLeft(parseWorkers);
+
+    std::vector<std::thread> threads;
+    threads.emplace_back(&CollectionPipeline::discoverMovies, this, year);
+    for (int t = 0; t < fetchWorkers; t++) {
+        threads.emplace_back(&CollectionPipeline::fetchMovies, this, std::ref(fetchersLeft));
+    }
+    for (int t = 0; t < parseWorkers; t++) {
+        threads.emplace_back(&CollectionPipeline::parseMovies, this, std::ref(parsersLeft));
+    }
+    threads.emplace_back(&CollectionPipeline::writeMovies, this);
+
+    // Report progress from this thread until the writer has saved the last movie
+    {
+        std::unique_lock<std::mutex> lock(finishedMutex);
+        while (!finishedSignal.wait_for(lock, options.reportInterval, [&]() { return finished; })) {
+            lock.unlock();
+            printStats();
+            lock.lock();
+        }
+    }
+
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    printStats();
+    return getStats();
+}
+
+//=====================================================================================
+//                          Stages
+//=====================================================================================
+
+void CollectionPipeline::discoverMovies(int year) {
+    // Pages stop once they come back empty, TMDB serves at most 500 per query
+    constexpr int MAX_PAGES = 500;
+
+    HttpFetcher fetcher(1);
+    fetcher.setRateLimiter(&limiter);
+    for (int page = 1; page <= MAX_PAGES; page++) {
+        HttpResponse response = fetcher.fetch(buildDiscoverURL(page, year));
+        if (response.body.empty()) {
+            std::cerr << std::format("Failed to retrieve page {} of year {}\n", page, year);
+            break;
+        }
+
+        std::vector<int> pageIds = extractMovieIDs(response.body);
+        if (pageIds.empty()) {
+            break;
+        }
+        pagesFetched++;
+        bool accepted = true;
+        for (int movieID : pageIds) {
+            accepted = accepted && movieIds.push(movieID);
+        }
+        if (!accepted) {
+            break; // The writer failed, nothing more would be saved
+        }
+    }
+    movieIds.close();
+}
+
+void CollectionPipeline::fetchMovies(std::atomic<int>& fetchersLeft) {
+    HttpFetcher fetcher(options.requestsPerWorker);
+    fetcher.setRateLimiter(&limiter);
+
+    // Take as many IDs as there are request slots (waiting only for the first), and fetch them together
+    // Stops early once pushes are refused, which means the writer has failed
+    std::vector<int> batch;
+    std::vector<std::string> urls;
+    bool accepted = true;
+    while (accepted) {
+        std::optional<int> first = movieIds.pop();
+        if (!first) {
+            break;
+        }
+        batch.assign(1, *first);
+        while (static_cast<int>(batch.size()) < fetcher.getMaxInFlight()) {
+            std::optional<int> next = movieIds.tryPop();
+            if (!next) {
+                break;
+            }
+            batch.push_back(*next);
+        }
+
+        urls.clear();
+        for (int movieID : batch) {
+            urls.push_back(buildMovieURL(movieID));
+        }
+        fetcher.fetchAll(urls, [&](size_t index, HttpResponse& response) {
+            moviesFetched++;
+            accepted = responses.push(std::make_pair(batch[index], std::move(response))) && accepted;
+        });
+    }
+
+    if (--fetchersLeft == 0) {
+        responses.close();
+    }
+}
+
+void CollectionPipeline::parseMovies(std::atomic<int>& parsersLeft) {
+    while (std::optional<std::pair<int, HttpResponse>> response = responses.pop()) {
+        MovieRecord movie;
+        if (parseMovieResponse(response->first, response->second, movie)) {
+            moviesParsed++;
+            movies.push(std::move(movie));
+        }
+    }
+
+    if (--parsersLeft == 0) {
+        movies.close();
+    }
+}
+
+void CollectionPipeline::writeMovies() {
+    try {
+        MovieWriter writer(db, options.moviesPerTransaction, options.maxTransactionDelay);
+        auto updateCounts = [&]() {
+            moviesWritten = writer.getMoviesWritten();
+            creditsWritten = writer.getCreditsWritten();
+            transactions = writer.getCommitCount();
+        };
+
+        // The writer commits on its own once a transaction is full or overdue, so it only
+        // needs waking at the deadline when no more movies come in before it
+        while (true) {
+            std::optional<MovieRecord> movie = writer.hasPending() ? movies.popUntil(writer.getCommitDeadline()) : movies.pop();
+            if (movie) {
+                writer.add(*movie);
+            }
+            else if (movies.isDrained()) {
+                break;
+            }
+            else {
+                writer.commitIfDue();
+            }
+            updateCounts();
+        }
+
+        writer.commit();
+        updateCounts();
+        writer.printStatistics();
+    }
+    catch (const std::exception& e) {
+        // Nothing can be saved anymore, so every stage is told to stop: their pushes start failing,
+        // discover and fetch stop requesting, and the parsers drop what they already have
+        std::cerr << std::format("Database writer failed: {} \n", e.what());
+        movieIds.close();
+        responses.close();
+        movies.close();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(finishedMutex);
+        finished = true;
+    }
+    finishedSignal.notify_all();
+}
+
+//=====================================================================================
+//                          Statistics
+//=====================================================================================
+
+CollectionPipeline::Stats CollectionPipeline::getStats() const {
+    Stats stats;
+    stats.pagesFetched = pagesFetched;
+    stats.moviesFetched = moviesFetched;
+    stats.moviesParsed = moviesParsed;
+    stats.moviesWritten = moviesWritten;
+    stats.creditsWritten = creditsWritten;
+    stats.transactions = transactions;
+    stats.idQueueDepth = movieIds.size();
+    stats.responseQueueDepth = responses.size();
+    stats.movieQueueDepth = movies.size();
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    return stats;
+}
+
+void CollectionPipeline::printStats() const {
+    Stats stats = getStats();
+    double seconds = std::max(stats.seconds, 1e-9);
+    std::cout << std::format("Pipeline: {} pages | fetched {} ({:.1f}/s), parsed {} ({:.1f}/s), written {} ({:.1f}/s) in {} transactions"
+        " | queued: {}/{} IDs, {}/{} responses, {}/{} movies\n",
+        stats.pagesFetched, stats.moviesFetched, stats.moviesFetched / seconds, stats.moviesParsed, stats.moviesParsed / seconds,
+        stats.moviesWritten, stats.moviesWritten / seconds, stats.transactions,
+        stats.idQueueDepth, movieIds.getCapacity(), stats.responseQueueDepth, responses.getCapacity(),
+        stats.movieQueueDepth, movies.getCapacity());
+}
@@ -0,0 +1,105 @@
+#ifndef COLLECTIONPIPELINE_H
+#define COLLECTIONPIPELINE_H
+
+#include <SQLiteCpp/SQLiteCpp.h>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <condition_variable>
+#include <utility>
+#include <cstddef>
+#include "boundedQueue.h"
+#include "httpFetcher.h"
+#include "rateLimiter.h"
+#include "movieWriter.h"
+#include "dataCollection.h"
+
+//=====================================================================================
+//                              CollectionPipeline Class
+//=====================================================================================
+// Collects a year of movies in stages that run at the same time, joined by bounded queues:
+//
+//   discover thread -> movie IDs -> fetch threads -> responses -> parse threads -> movies -> writer thread
+//
+// The discover thread walks the year's discover pages, the fetch threads download movie
+// details (sharing one rate limiter), the parse threads pull the cast out of the JSON, and a
+// single MovieWriter saves them many to a transaction. So the network, the CPU and the disk
+// all stay busy, and a full queue makes the stage before it wait instead of piling up memory.
+// A pipeline collects one year, make a new one for the next.
+class CollectionPipeline {
+public:
+    struct Options {
+        int fetchWorkers;                               // Threads fetching movie details, each with its own connections
+        int requestsPerWorker;                          // Requests each of them keeps in flight
+        int parseWorkers;                               // Threads parsing responses
+        size_t queueCapacity;                           // Items a queue holds before the stage feeding it waits
+        size_t moviesPerTransaction;                    // The writer commits once this many movies are waiting,
+        std::chrono::milliseconds maxTransactionDelay;  // or the oldest of them has waited this long
+        std::chrono::seconds reportInterval;            // How often the progress line is printed
+
+        Options()
+            : fetchWorkers(4), requestsPerWorker(4), parseWorkers(2), queueCapacity(256),
+            moviesPerTransaction(500), maxTransactionDelay(2000), reportInterval(10) {
+        }
+    };
+
+    // Progress so far, and how full each queue is right now
+    struct Stats {
+        size_t pagesFetched;
+        size_t moviesFetched;
+        size_t moviesParsed;
+        size_t moviesWritten;
+        size_t creditsWritten;      // Cast links saved
+        size_t transactions;
+        size_t idQueueDepth;
+        size_t responseQueueDepth;
+        size_t movieQueueDepth;
+        double seconds;             // Since the run started
+
+        Stats()
+            : pagesFetched(0), moviesFetched(0), moviesParsed(0), moviesWritten(0), creditsWritten(0), transactions(0),
+            idQueueDepth(0), responseQueueDepth(0), movieQueueDepth(0), seconds(0.0) {
+        }
+    };
+
+    CollectionPipeline(SQLite::Database& db, RateLimiter& limiter, const Options& options = Options());
+
+    // Collect every movie of a year into the database, returns once all of it is written
+    Stats run(int year);
+
+    // Safe to call from any thread while the pipeline runs
+    Stats getStats() const;
+
+    // One line of progress: counts and rates per stage, and the queue depths
+    void printStats() const;
+
+private:
+    SQLite::Database& db;
+    RateLimiter& limiter;
+    Options options;
+
+    BoundedQueue<int> movieIds;
+    BoundedQueue<std::pair<int, HttpResponse>> responses;
+    BoundedQueue<MovieRecord> movies;
+
+    std::atomic<size_t> pagesFetched;
+    std::atomic<size_t> moviesFetched;
+    std::atomic<size_t> moviesParsed;
+    std::atomic<size_t> moviesWritten;
+    std::atomic<size_t> creditsWritten;
+    std::atomic<size_t> transactions;
+    std::chrono::steady_clock::time_point startTime;
+
+    // Signalled by the writer once everything is saved
+    std::mutex finishedMutex;
+    std::condition_variable finishedSignal;
+    bool finished;
+
+    // The stages, each closes its output queue when its last thread is done
+    void discoverMovies(int year);
+    void fetchMovies(std::atomic<int>& fetchersLeft);
+    void parseMovies(std::atomic<int>& parsersLeft);
+    void writeMovies();
+};
+
+#endif // COLLECTIONPIPELINE_H
@@ -18,29 +18,41 @@
 
 
 namespace Config {
-	const std::string TMDB_API_KEY = [] {
-		if (!changeToGitRoot()) {
-			std::cerr << "FATAL: Could not access Git directory. Aborting worker.\n";
-			exit(1);
-		}
-		try {
-			std::ifstream file("assets/config.cfg");
-			if (!file.is_open()) {
-				throw std::runtime_error("COULD NOT OPEN CONFIG!\nCheck File Path\n");
+	//The config file is read once, the first time any setting needs it
+	static const json& configData() {
+		static const json data = [] {
+			if (!changeToGitRoot()) {
+				std::cerr << "FATAL: Could not access Git directory. Aborting worker.\n";
+				exit(1);
 			}
-			json data = json::parse(file);
-			std::string key = data.value("tmdb_api_key", "");
-			if (key.empty()) {
-				throw std::runtime_error("Don't forget to put your API key in assets/config.cfg!\n");
+			try {
+				std::ifstream file("assets/config.cfg");
+				if (!file.is_open()) {
+					throw std::runtime_error("COULD NOT OPEN CONFIG!\nCheck File Path\n");
+				}
+				return json::parse(file);
 			}
-			return key;
-		}
-		catch (const std::exception& e) {
-			std::cerr << "FATAL Configuration Error: Failed to load TMDB_KEY: " << e.what() << "\n";
+			catch (const std::exception& e) {
+				std::cerr << "FATAL Configuration Error: Failed to load TMDB_KEY: " << e.what() << "\n";
+				exit(1);
+			}
+		}();
+		return data;
+	}
+
+	const std::string TMDB_API_KEY = [] {
+		std::string key = configData().value("tmdb_api_key", "");
+		if (key.empty()) {
+			std::cerr << "FATAL Configuration Error: Failed to load TMDB_KEY: Don't forget to put your API key in assets/config.cfg!\n";
 			exit(1);
 		}
+		return key;
 	}();
 
+	const std::string TMDB_BASE_URL = configData().value("tmdb_base_url", "https://api.themoviedb.org/3/");
+
+	const double TMDB_REQUESTS_PER_SECOND = configData().value("requests_per_second", 40.0);
+
 	void loadConfig() {
 		if (TMDB_API_KEY.empty()) {
 			throw std::runtime_error("TMDB API Key is not set!");
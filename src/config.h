@@ -19,6 +19,10 @@ using json = nlohmann::json;
 
 namespace Config {
 	extern const std::string TMDB_API_KEY;
+	//Where requests go, a local mock server can stand in for TMDB by setting "tmdb_base_url"
+	extern const std::string TMDB_BASE_URL;
+	//Request budget shared by every fetcher, from "requests_per_second" (TMDB allows around 40)
+	extern const double TMDB_REQUESTS_PER_SECOND;
 
 	void loadConfig();
 }
\ No newline at end of file
@@ -0,0 +1,603 @@
+#include "contractionHierarchy.h"
+#include "dijkstra.h"
+#include "priorityQueues.h"
+#include "checksum.h"
+#include <iostream>
+#include <format>
+#include <fstream>
+#include <chrono>
+#include <algorithm>
+#include <numeric>
+#include <thread>
+#include <atomic>
+
+//=====================================================================================
+//                              Constructor
+//=====================================================================================
+
+ContractionHierarchy::ContractionHierarchy()
+    : actorCount(0), coreSize(0), shortcutCount(0), graphFingerprint(0), buildTimeMs(0.0) {
+}
+
+//=====================================================================================
+//                              Building
+//=====================================================================================
+
+namespace {
+    // Actors a witness search may settle before giving up (and keeping the shortcut, which is
+    // never wrong, only sometimes unnecessary)
+    constexpr int WITNESS_SETTLE_LIMIT = 100;
+
+    // Edge of the graph being contracted, stored at both ends
+    struct Arc {
+        int target;
+        int middle;     // Actor the edge skips, -1 for an edge of the graph itself
+        double cost;
+    };
+
+    struct Shortcut {
+        int from;
+        int to;
+        int middle;
+        double cost;
+    };
+
+    // Scratch for witness searches, each thread has its own
+    // Actors count as reached (or as targets) only if they carry the current search number
+    struct WitnessSearch {
+        std::vector<double> cost;
+        std::vector<double> limit;              // For targets, the cost through the contracted actor
+        std::vector<std::uint32_t> reached;
+        std::vector<std::uint32_t> target;      // Cleared once a witness is found
+        IndexedDaryHeap<double> heap;
+        std::uint32_t searchNumber = 0;
+
+        explicit WitnessSearch(size_t actorCount)
+            : cost(actorCount), limit(actorCount), reached(actorCount, 0), target(actorCount, 0) {
+            heap.reserveIndices(actorCount);
+        }
+    };
+
+    // Runs work(thread, item) for every item below count, spread over the threads
+    template <typename Work>
+    void parallelFor(int count, unsigned int threadCount, Work work) {
+        std::atomic<int> nextItem(0);
+        auto worker = [&](unsigned int t) {
+            for (int item = nextItem++; item < count; item = nextItem++) {
+                work(t, item);
+            }
+        };
+
+        std::vector<std::thread> threads;
+        for (unsigned int t = 1; t < std::min<unsigned int>(threadCount, std::max(count, 0)); t++) {
+            threads.emplace_back(worker, t);
+        }
+        worker(0);
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+    }
+
+    // Shortcuts needed to contract actor v: for every pair of its neighbors u, w, a search from u
+    // that avoids v looks for a witness path no more costly than u -> v -> w
+    // It also avoids every actor marked in contracting, the others being contracted alongside v
+    // (with ties everywhere, two of them would otherwise each be the other's witness, and neither
+    // would keep the shortcut)
+    // The arcs are only read, so several threads can do this at once
+    void findShortcuts(const std::vector<std::vector<Arc>>& arcs, int v, const std::vector<char>& contracting,
+        int settleLimit, WitnessSearch& search, std::vector<Shortcut>& shortcuts) {
+        const std::vector<Arc>& around = arcs[v];
+        for (size_t i = 0; i + 1 < around.size(); i++) {
+            int source = around[i].target;
+            std::uint32_t number = ++search.searchNumber;
+
+            // Each pair is only checked from its first neighbor
+            double maxCost = 0.0;
+            int pending = 0;
+            for (size_t j = i + 1; j < around.size(); j++) {
+                int w = around[j].target;
+                search.target[w] = number;
+                search.limit[w] = around[i].cost + around[j].cost;
+                maxCost = std::max(maxCost, search.limit[w]);
+                pending++;
+            }
+
+            search.heap.clear();
+            search.reached[source] = number;
+            search.cost[source] = 0.0;
+            search.heap.push(0.0, source);
+
+            int settled = 0;
+            while (!search.heap.empty() && pending > 0 && settled < settleLimit) {
+                auto [currentCost, current] = search.heap.pop();
+                settled++;
+
+                for (const Arc& arc : arcs[current]) {
+                    int next = arc.target;
+                    double newCost = currentCost + arc.cost;
+                    if (next == v || contracting[next] || newCost > maxCost) {
+                        continue;
+                    }
+
+                    if (search.reached[next] != number || newCost < search.cost[next]) {
+                        search.reached[next] = number;
+                        search.cost[next] = newCost;
+                        search.heap.push(newCost, next);
+
+                        // A tentative cost is already a real path, so it's a witness as soon as it's cheap enough
+                        if (search.target[next] == number && newCost <= search.limit[next]) {
+                            search.target[next] = 0;
+                            pending--;
+                        }
+                    }
+                }
+            }
+
+            for (size_t j = i + 1; j < around.size(); j++) {
+                int w = around[j].target;
+                if (search.target[w] == number) {
+                    shortcuts.push_back({ source, w, v, search.limit[w] });
+                }
+            }
+        }
+    }
+
+    // Drops every arc of the given actors that has a strictly cheaper path around it, such an arc
+    // is never part of a strongest path. The searches all run before anything is removed, which
+    // is safe because two arcs can't each be strictly cheaper to go around than the other.
+    void removeRedundantArcs(
+        std::vector<std::vector<Arc>>& arcs,
+        const std::vector<int>& actors,
+        unsigned int threadCount,
+        std::vector<WitnessSearch>& searches
+    ) {
+        std::vector<std::vector<int>> redundant(actors.size());
+        parallelFor(static_cast<int>(actors.size()), threadCount, [&](unsigned int t, int i) {
+            int u = actors[i];
+            WitnessSearch& search = searches[t];
+            std::uint32_t number = ++search.searchNumber;
+
+            double maxCost = 0.0;
+            for (const Arc& arc : arcs[u]) {
+                maxCost = std::max(maxCost, arc.cost);
+            }
+
+            search.heap.clear();
+            search.reached[u] = number;
+            search.cost[u] = 0.0;
+            search.heap.push(0.0, u);
+
+            int settled = 0;
+            while (!search.heap.empty() && settled < WITNESS_SETTLE_LIMIT) {
+                auto [currentCost, current] = search.heap.pop();
+                settled++;
+
+                for (const Arc& arc : arcs[current]) {
+                    double newCost = currentCost + arc.cost;
+                    if (newCost >= maxCost) {
+                        continue;
+                    }
+                    if (search.reached[arc.target] != number || newCost < search.cost[arc.target]) {
+                        search.reached[arc.target] = number;
+                        search.cost[arc.target] = newCost;
+                        search.heap.push(newCost, arc.target);
+                    }
+                }
+            }
+
+            for (const Arc& arc : arcs[u]) {
+                if (search.reached[arc.target] == number && search.cost[arc.target] < arc.cost) {
+                    redundant[i].push_back(arc.target);
+                }
+            }
+        });
+
+        // Either end may have found it, so each arc is removed from both
+        std::vector<std::pair<int, int>> removals;
+        for (size_t i = 0; i < actors.size(); i++) {
+            for (int w : redundant[i]) {
+                removals.push_back({ actors[i], w });
+                removals.push_back({ w, actors[i] });
+            }
+        }
+        std::sort(removals.begin(), removals.end());
+
+        std::vector<size_t> groupStarts;
+        for (size_t k = 0; k < removals.size(); k++) {
+            if (k == 0 || removals[k].first != removals[k - 1].first) {
+                groupStarts.push_back(k);
+            }
+        }
+        groupStarts.push_back(removals.size());
+
+        parallelFor(static_cast<int>(groupStarts.size()) - 1, threadCount, [&](unsigned int t, int g) {
+            WitnessSearch& search = searches[t];
+            std::uint32_t number = ++search.searchNumber;
+            int u = removals[groupStarts[g]].first;
+            for (size_t k = groupStarts[g]; k < groupStarts[g + 1]; k++) {
+                search.target[removals[k].second] = number;
+            }
+            std::erase_if(arcs[u], [&](const Arc& arc) { return search.target[arc.target] == number; });
+        });
+    }
+}
+
+void ContractionHierarchy::build(const Graph& graph, unsigned int threadCount) {
+    auto startTime = std::chrono::high_resolution_clock::now();
+
+    *this = ContractionHierarchy();
+    actorCount = graph.getActorCount();
+    graphFingerprint = graph.getFingerprint();
+    int count = static_cast<int>(actorCount);
+
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    // Working copy of the graph with the strongest-path costs, shortcuts get added to it
+    // An actor's arcs only ever point at actors that are still uncontracted
+    int maxWeight = graph.getMaxWeight();
+    std::vector<std::vector<Arc>> arcs(actorCount);
+    for (int index = 0; index < count; index++) {
+        std::span<const int> neighborIndices = graph.getNeighborIndices(index);
+        std::span<const int> neighborWeights = graph.getNeighborWeights(index);
+        arcs[index].reserve(neighborIndices.size());
+        for (size_t i = 0; i < neighborIndices.size(); i++) {
+            if (neighborIndices[i] != index) {
+                arcs[index].push_back({ neighborIndices[i], -1, Dijkstra::weightToCost(neighborWeights[i], maxWeight) });
+            }
+        }
+    }
+
+    std::vector<WitnessSearch> searches;
+    for (unsigned int t = 0; t < threadCount; t++) {
+        searches.emplace_back(actorCount);
+    }
+
+    // About a third of the co-star edges are weaker than some path around them, dropping them
+    // first leaves fewer neighbors per actor and so far fewer shortcuts
+    std::vector<int> remaining(actorCount);
+    std::iota(remaining.begin(), remaining.end(), 0);
+    removeRedundantArcs(arcs, remaining, threadCount, searches);
+
+    // Priority = edge difference + neighbors already contracted, lowest goes first
+    // The first estimate only looks for direct edges as witnesses (a one actor search), it's
+    // refreshed with full witness searches whenever an actor comes up for contraction, and
+    // neighbors being contracted only bump the contracted count in between
+    // Actors over MAX_CONTRACTED_DEGREE count as "after everyone", until their degree drops
+    std::vector<int> priority(actorCount, 0);
+    std::vector<int> contractedNeighbors(actorCount, 0);
+    std::vector<char> isCandidate(actorCount, 0);
+    std::vector<std::vector<Shortcut>> threadShortcuts(threadCount);
+    parallelFor(count, threadCount, [&](unsigned int t, int index) {
+        if (arcs[index].size() <= MAX_CONTRACTED_DEGREE) {
+            threadShortcuts[t].clear();
+            findShortcuts(arcs, index, isCandidate, 1, searches[t], threadShortcuts[t]);
+            priority[index] = static_cast<int>(threadShortcuts[t].size()) - static_cast<int>(arcs[index].size());
+        }
+    });
+
+    // Ties are broken by index, so two neighbors are never both "lower than all their neighbors"
+    auto contractsBefore = [&](int a, int priorityA, int b) {
+        return arcs[b].size() > MAX_CONTRACTED_DEGREE || priorityA < priority[b] || (priorityA == priority[b] && a < b);
+    };
+
+    rank.assign(actorCount, -1);
+    int nextRank = 0;
+    std::vector<int> candidates;
+    std::vector<char> accepted;
+    std::vector<std::vector<Shortcut>> candidateShortcuts;
+    std::vector<std::pair<int, Arc>> updates;
+    std::vector<int> touched;
+    std::vector<std::vector<int>> arcPositions(threadCount, std::vector<int>(actorCount, -1));
+
+    // Rounds go on until no actor within the degree limit is left
+    while (true) {
+        // Candidates: actors that come before every remaining neighbor (an independent set)
+        parallelFor(static_cast<int>(remaining.size()), threadCount, [&](unsigned int, int i) {
+            int v = remaining[i];
+            bool lowest = arcs[v].size() <= MAX_CONTRACTED_DEGREE;
+            for (const Arc& arc : arcs[v]) {
+                if (!contractsBefore(v, priority[v], arc.target)) {
+                    lowest = false;
+                    break;
+                }
+            }
+            isCandidate[v] = lowest;
+        });
+        candidates.clear();
+        for (int v : remaining) {
+            if (isCandidate[v]) {
+                candidates.push_back(v);
+            }
+        }
+        if (candidates.empty()) {
+            break;
+        }
+
+        // Simulate each candidate's contraction in parallel, and only contract those that are still
+        // the lowest once their priority is up to date (the others keep the new priority for later)
+        candidateShortcuts.resize(candidates.size());
+        accepted.assign(candidates.size(), 0);
+        parallelFor(static_cast<int>(candidates.size()), threadCount, [&](unsigned int t, int i) {
+            int v = candidates[i];
+            candidateShortcuts[i].clear();
+            findShortcuts(arcs, v, isCandidate, WITNESS_SETTLE_LIMIT, searches[t], candidateShortcuts[i]);
+            int fresh = static_cast<int>(candidateShortcuts[i].size()) - static_cast<int>(arcs[v].size()) + contractedNeighbors[v];
+
+            bool lowest = true;
+            for (const Arc& arc : arcs[v]) {
+                if (!contractsBefore(v, fresh, arc.target)) {
+                    lowest = false;
+                    break;
+                }
+            }
+            priority[v] = fresh;
+            accepted[i] = lowest;
+        });
+
+        // Contract: the actor's arcs are frozen as its upward edges, and its shortcuts go to both ends
+        updates.clear();
+        touched.clear();
+        for (size_t i = 0; i < candidates.size(); i++) {
+            if (!accepted[i]) {
+                continue;
+            }
+            int v = candidates[i];
+            rank[v] = nextRank++;
+            for (const Arc& arc : arcs[v]) {
+                contractedNeighbors[arc.target]++;
+                priority[arc.target]++;
+                touched.push_back(arc.target);
+            }
+            for (const Shortcut& shortcut : candidateShortcuts[i]) {
+                updates.push_back({ shortcut.from, Arc{ shortcut.to, shortcut.middle, shortcut.cost } });
+                updates.push_back({ shortcut.to, Arc{ shortcut.from, shortcut.middle, shortcut.cost } });
+            }
+        }
+        std::sort(touched.begin(), touched.end());
+        touched.erase(std::unique(touched.begin(), touched.end()), touched.end());
+        std::sort(updates.begin(), updates.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+
+        // Each touched actor drops its arcs to contracted actors and takes its shortcuts, keeping
+        // the cheaper one if it already had an arc to the same actor
+        parallelFor(static_cast<int>(touched.size()), threadCount, [&](unsigned int t, int i) {
+            int u = touched[i];
+            std::vector<Arc>& list = arcs[u];
+            std::vector<int>& position = arcPositions[t];
+            list.erase(std::remove_if(list.begin(), list.end(), [&](const Arc& arc) { return rank[arc.target] != -1; }), list.end());
+            for (size_t k = 0; k < list.size(); k++) {
+                position[list[k].target] = static_cast<int>(k);
+            }
+
+            auto range = std::equal_range(updates.begin(), updates.end(), std::pair<int, Arc>{ u, Arc{} },
+                [](const auto& a, const auto& b) { return a.first < b.first; });
+            for (auto it = range.first; it != range.second; ++it) {
+                const Arc& arc = it->second;
+                int k = position[arc.target];
+                if (k == -1) {
+                    position[arc.target] = static_cast<int>(list.size());
+                    list.push_back(arc);
+                }
+                else if (arc.cost < list[k].cost) {
+                    list[k] = arc;
+                }
+            }
+
+            for (const Arc& arc : list) {
+                position[arc.target] = -1;
+            }
+        });
+
+        remaining.erase(std::remove_if(remaining.begin(), remaining.end(), [&](int v) { return rank[v] != -1; }), remaining.end());
+    }
+
+    // Whatever is left is the core, its arcs already point at each other only
+    // The shortcuts made many of its arcs redundant again, and every core arc is searched in both directions
+    removeRedundantArcs(arcs, remaining, threadCount, searches);
+    coreSize = remaining.size();
+    for (int v : remaining) {
+        rank[v] = nextRank++;
+    }
+
+    // Pack the upward edges into CSR arrays, sorted by target for unpacking
+    upOffsets.assign(actorCount + 1, 0);
+    for (size_t index = 0; index < actorCount; index++) {
+        upOffsets[index + 1] = upOffsets[index] + arcs[index].size();
+    }
+    upTargets.reserve(upOffsets.back());
+    upCosts.reserve(upOffsets.back());
+    upMiddles.reserve(upOffsets.back());
+    for (auto& list : arcs) {
+        std::sort(list.begin(), list.end(), [](const Arc& a, const Arc& b) { return a.target < b.target; });
+        for (const Arc& arc : list) {
+            upTargets.push_back(arc.target);
+            upCosts.push_back(arc.cost);
+            upMiddles.push_back(arc.middle);
+            if (arc.middle != -1) {
+                shortcutCount++;
+            }
+        }
+        std::vector<Arc>().swap(list);
+    }
+
+    auto endTime = std::chrono::high_resolution_clock::now();
+    buildTimeMs = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+}
+
+//=====================================================================================
+//                              Hierarchy Files
+//=====================================================================================
+// File layout: a fixed header, then each array as its own section, padded to 8 bytes
+// Bump HIERARCHY_FILE_VERSION on any layout change, or when older builds gave wrong hierarchies
+// (version 1 could drop shortcuts between actors contracted in the same round).
+
+namespace {
+    constexpr char HIERARCHY_MAGIC[8] = { 'A', 'C', 'T', 'C', 'H', 'I', 'E', 'R' };
+    constexpr std::uint32_t HIERARCHY_FILE_VERSION = 2;
+
+    struct HierarchyHeader {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t headerSize;       // Catches layout changes that forgot the version bump
+        std::uint64_t actorCount;
+        std::uint64_t edgeCount;        // Upward edges over all actors
+        std::uint64_t coreSize;
+        std::uint64_t shortcutCount;
+        std::uint64_t graphFingerprint; // Graph::getFingerprint() of the graph it was built for
+        std::uint64_t payloadChecksum;  // Over everything after the header
+    };
+    static_assert(sizeof(HierarchyHeader) % 8 == 0, "Hierarchy sections must stay 8 byte aligned");
+}
+
+bool ContractionHierarchy::save(const std::string& path) const {
+    HierarchyHeader header{};
+    header.actorCount = actorCount;
+    header.edgeCount = upTargets.size();
+    header.coreSize = coreSize;
+    header.shortcutCount = shortcutCount;
+    header.graphFingerprint = graphFingerprint;
+
+    bool saved = writeFramedFile(path, "contraction hierarchy", HIERARCHY_MAGIC, HIERARCHY_FILE_VERSION, header,
+        [&](std::ofstream& file, std::uint64_t& checksum) {
+            writeSection(file, checksum, rank.data(), rank.size() * sizeof(int));
+            writeSection(file, checksum, upOffsets.data(), upOffsets.size() * sizeof(std::uint64_t));
+            writeSection(file, checksum, upCosts.data(), upCosts.size() * sizeof(double));
+            writeSection(file, checksum, upTargets.data(), upTargets.size() * sizeof(int));
+            writeSection(file, checksum, upMiddles.data(), upMiddles.size() * sizeof(int));
+        });
+    if (!saved) {
+        return false;
+    }
+
+    std::cout << std::format("Contraction hierarchy saved to {}\n", path);
+    return true;
+}
+
+bool ContractionHierarchy::load(const std::string& path, const Graph& graph) {
+    auto startTime = std::chrono::high_resolution_clock::now();
+    *this = ContractionHierarchy();
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    HierarchyHeader header;
+    if (!readFileHeader(file, path, "Contraction hierarchy file", HIERARCHY_MAGIC, HIERARCHY_FILE_VERSION, header)) {
+        return false;
+    }
+
+    if (header.actorCount != graph.getActorCount() || header.graphFingerprint != graph.getFingerprint()) {
+        std::cerr << std::format("Warning: Contraction hierarchy file {} was built for a different graph, ignoring it.\n", path);
+        return false;
+    }
+
+    if (!checkFileLayout<HierarchyHeader>(path, "Contraction hierarchy file", { header.actorCount * sizeof(int),
+        (header.actorCount + 1) * sizeof(std::uint64_t), header.edgeCount * sizeof(double),
+        header.edgeCount * sizeof(int), header.edgeCount * sizeof(int) })) {
+        return false;
+    }
+
+    ContractionHierarchy loaded;
+    std::uint64_t checksum = CHECKSUM_SEED;
+    readSection(file, checksum, loaded.rank, header.actorCount);
+    readSection(file, checksum, loaded.upOffsets, header.actorCount + 1);
+    readSection(file, checksum, loaded.upCosts, header.edgeCount);
+    readSection(file, checksum, loaded.upTargets, header.edgeCount);
+    readSection(file, checksum, loaded.upMiddles, header.edgeCount);
+    if (!file || checksum != header.payloadChecksum) {
+        std::cerr << std::format("Warning: Contraction hierarchy file {} failed its checksum, ignoring it.\n", path);
+        return false;
+    }
+
+    if (loaded.upOffsets.front() != 0 || loaded.upOffsets.back() != header.edgeCount) {
+        std::cerr << std::format("Warning: Contraction hierarchy file {} has inconsistent arrays, ignoring it.\n", path);
+        return false;
+    }
+
+    loaded.actorCount = header.actorCount;
+    loaded.coreSize = header.coreSize;
+    loaded.shortcutCount = header.shortcutCount;
+    loaded.graphFingerprint = header.graphFingerprint;
+    *this = std::move(loaded);
+
+    auto endTime = std::chrono::high_resolution_clock::now();
+    std::cout << std::format("Contraction hierarchy {} loaded in {:.1f} ms\n", path,
+        std::chrono::duration<double, std::milli>(endTime - startTime).count());
+    return true;
+}
+
+bool ContractionHierarchy::empty() const {
+    return upOffsets.empty();
+}
+
+//=====================================================================================
+//                              Query Methods
+//=====================================================================================
+
+bool ContractionHierarchy::matches(const Graph& graph) const {
+    return !empty() && actorCount == graph.getActorCount() && graphFingerprint == graph.getFingerprint();
+}
+
+bool ContractionHierarchy::isCore(int index) const {
+    return static_cast<size_t>(rank[index]) >= actorCount - coreSize;
+}
+
+std::span<const int> ContractionHierarchy::getUpwardTargets(int index) const {
+    return std::span<const int>(upTargets).subspan(upOffsets[index], upOffsets[index + 1] - upOffsets[index]);
+}
+
+std::span<const double> ContractionHierarchy::getUpwardCosts(int index) const {
+    return std::span<const double>(upCosts).subspan(upOffsets[index], upOffsets[index + 1] - upOffsets[index]);
+}
+
+void ContractionHierarchy::unpackEdge(int from, int to, std::vector<int>& path) const {
+    // Shortcuts nest, so unpack with a stack of edges still to expand, first edge on top
+    std::vector<std::pair<int, int>> pending = { { from, to } };
+    while (!pending.empty()) {
+        auto [a, b] = pending.back();
+        pending.pop_back();
+
+        std::int64_t edge = findEdge(a, b);
+        int middle = edge == -1 ? -1 : upMiddles[edge];
+        if (middle == -1) {
+            path.push_back(b);
+        }
+        else {
+            pending.push_back({ middle, b });
+            pending.push_back({ a, middle });
+        }
+    }
+}
+
+void ContractionHierarchy::printStatistics() const {
+    std::cout << "\n=== Contraction Hierarchy Statistics ===\n";
+    std::cout << std::format("Actors: {}\n", actorCount);
+    std::cout << std::format("Core Actors: {}\n", coreSize);
+    std::cout << std::format("Upward Edges: {}\n", upTargets.size());
+    std::cout << std::format("Shortcuts: {}\n", shortcutCount);
+    std::cout << std::format("Index Size: {} MB\n",
+        (upTargets.size() * (2 * sizeof(int) + sizeof(double)) + upOffsets.size() * sizeof(std::uint64_t)) / (1024 * 1024));
+    if (buildTimeMs > 0.0) {
+        std::cout << std::format("Build Time: {:.1f} ms\n", buildTimeMs);
+    }
+    std::cout << "========================================\n\n";
+}
+
+//=====================================================================================
+//                              Helper Methods
+//=====================================================================================
+
+std::int64_t ContractionHierarchy::findEdge(int from, int to) const {
+    // The edge is stored upward, at whichever end was contracted first (core edges at both)
+    int lower = rank[from] < rank[to] ? from : to;
+    int upper = lower == from ? to : from;
+    auto begin = upTargets.begin() + upOffsets[lower];
+    auto end = upTargets.begin() + upOffsets[lower + 1];
+    auto it = std::lower_bound(begin, end, upper);
+    if (it == end || *it != upper) {
+        return -1;
+    }
+    return it - upTargets.begin();
+}
@@ -0,0 +1,100 @@
+#ifndef CONTRACTIONHIERARCHY_H
+#define CONTRACTIONHIERARCHY_H
+
+#include "graph.h"
+#include <vector>
+#include <string>
+#include <span>
+#include <cstdint>
+#include <cstddef>
+
+//=====================================================================================
+//                          ContractionHierarchy Class
+//=====================================================================================
+// Contraction hierarchy over the strongest-path costs (Dijkstra::weightToCost of each edge).
+// Actors are contracted one by one, least important first: contracting an actor removes
+// it from the graph, and adds a shortcut between two of its neighbors whenever the path
+// through it was the only strongest one (no "witness" path around it was found).
+// Each shortcut remembers the actor it skips, so it can be unpacked back into real edges.
+//
+// Afterwards every actor keeps only its edges to actors contracted later ("upward"), so a
+// search from either end only ever climbs, and the two searches meet near the top.
+//
+// The order comes from the edge difference (shortcuts added - edges removed, plus the
+// neighbors already contracted so the hierarchy stays even). Each round contracts, in
+// parallel, every actor whose priority is lower than all of its remaining neighbors'.
+// A co-star graph is mostly overlapping casts, and contracting a well connected actor
+// would join most pairs of its neighbors with shortcuts, so actors with more than
+// MAX_CONTRACTED_DEGREE edges are never contracted. They form the "core", whose edges are
+// all kept in both directions and searched with a plain bidirectional Dijkstra.
+// Edges with a strictly cheaper path around them can never be on a strongest path, so
+// they are dropped before contracting and again from the finished core.
+//
+// Like the landmarks, the hierarchy is saved next to the database and tied to its graph.
+class ContractionHierarchy {
+public:
+    ContractionHierarchy();
+
+    //=====================================================================================
+    //                          Building and Files
+    //=====================================================================================
+
+    // Contract the graph (replaces the current hierarchy), threadCount of 0 uses every core
+    void build(const Graph& graph, unsigned int threadCount = 0);
+
+    // Write the hierarchy to a file, returns false on failure
+    bool save(const std::string& path) const;
+
+    // Replace the hierarchy with the one in a file
+    // Returns false (and leaves the hierarchy empty) if the file is missing, corrupt, or built for another graph
+    bool load(const std::string& path, const Graph& graph);
+
+    // Whether there is anything to use (false before build/load)
+    bool empty() const;
+
+    //=====================================================================================
+    //                          Query Methods
+    //=====================================================================================
+
+    // Whether the hierarchy was built for this graph, by fingerprint (a reordered graph has the same
+    // actors but different indices, so the actor count alone isn't enough)
+    bool matches(const Graph& graph) const;
+
+    // Whether a dense index was left uncontracted in the core
+    bool isCore(int index) const;
+
+    // Upward edges of a dense index (sorted by target), core actors also list every core neighbor
+    std::span<const int> getUpwardTargets(int index) const;
+    std::span<const double> getUpwardCosts(int index) const;
+
+    // Appends the real edges behind the hierarchy edge from -> to, as the dense indices
+    // after from up to and including to
+    void unpackEdge(int from, int to, std::vector<int>& path) const;
+
+    // Shortcut count, core size and how long the build took
+    void printStatistics() const;
+
+    // Actors with more edges than this (shortcuts included) are left in the core
+    static constexpr size_t MAX_CONTRACTED_DEGREE = 64;
+
+private:
+    // Upward edges in CSR form, the edges of index v are [upOffsets[v] .. upOffsets[v + 1])
+    std::vector<std::uint64_t> upOffsets;
+    std::vector<int> upTargets;
+    std::vector<double> upCosts;
+    std::vector<int> upMiddles;         // Actor a shortcut skips, -1 for an edge of the graph itself
+
+    // Contraction order, core actors come last
+    std::vector<int> rank;
+
+    size_t actorCount;
+    size_t coreSize;
+    size_t shortcutCount;
+    std::uint64_t graphFingerprint;
+    double buildTimeMs;
+
+    // Position of the edge between two dense indices in the upward lists, or -1
+    std::int64_t findEdge(int from, int to) const;
+};
+
+#endif // CONTRACTIONHIERARCHY_H
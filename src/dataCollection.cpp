@@ -1,5 +1,4 @@
 //Libraries for data collection
-#include <curl/curl.h> //For HTTP requests
 #include <nlohmann/json.hpp>    //For JSON parsing
 #include <SQLiteCpp/SQLiteCpp.h> //For SQLite database
 //A bunch of C++ built in libraries
@@ -13,8 +12,23 @@
 #include <utility>
 #include <cstdlib>
 #include <thread>
+#include <algorithm>
 #include "dataCollection.h"
+#include "graph.h"
 #include "config.h"
+#include "collectionPipeline.h"
+
+//Where the graph snapshot is saved next to the main database
+const std::string GRAPH_SNAPSHOT_PATH = "assets/movieData.graph";
+//Order the main graph's indices are renumbered in before its snapshot is saved, see compareIndexOrders()
+//Putting the hubs first made BFS about 30% and Dijkstra about 25% faster than ID order on the movie graph
+const Graph::IndexOrder MAIN_GRAPH_ORDER = Graph::IndexOrder::Degree;
+//Where the landmark costs for A* are saved, they only match the graph they were built from
+const std::string LANDMARKS_PATH = "assets/movieData.landmarks";
+//Where the hop label index is saved, same as the landmarks it only matches the graph it was built from
+const std::string HOP_LABELS_PATH = "assets/movieData.labels";
+//Where the contraction hierarchy is saved, also tied to the graph it was built from
+const std::string HIERARCHY_PATH = "assets/movieData.hierarchy";
 
 //=====================================================================================
 //=====================================================================================
@@ -22,45 +36,115 @@
 //=====================================================================================
 //=====================================================================================
 
-ActorGraph loadActorDataFromDB(SQLite::Database& db) {
-	ActorGraph allData;
-	auto& actorDataMap = allData.first;
-	auto& nameToIDMap = allData.second;
-	SQLite::Statement actorQuery(db, "SELECT actor_id, actor_name FROM Actors");
-	SQLite::Statement edgeQuery(db, "SELECT actor1_id, actor2_id, weight FROM Actor_Edges");
-	int actorCount = 0;
-	int edgeCount = 0;
+ActorGraph::ActorGraph(GraphSnapshot graph) : graph(std::move(graph)) {
+}
 
-	try {
-		std::cout << "Loading actors from the 'Actors' table...\n";
-		{
-			while (actorQuery.executeStep()) {
-				int id = actorQuery.getColumn(0).getInt();
-				std::string name = actorQuery.getColumn(1).getString();
-				actorDataMap.emplace(id, ActorData{ name, {} });
-				nameToIDMap[name].push_back(id);
-
-				actorCount++;
-			}
+size_t ActorGraph::size() const {
+	return graph->getActorCount();
+}
+
+bool ActorGraph::contains(int actorID) const {
+	return graph->hasActor(actorID);
+}
+
+ActorData ActorGraph::at(int actorID) const {
+	int index = graph->getIndex(actorID);
+	if (index == -1) {
+		throw std::out_of_range(std::format("Actor ID {} is not in the graph", actorID));
+	}
+
+	ActorData data{ graph->getName(index), {} };
+	std::span<const int> neighborIndices = graph->getNeighborIndices(index);
+	std::span<const int> neighborWeights = graph->getNeighborWeights(index);
+	data.edges.reserve(neighborIndices.size());
+	for (size_t i = 0; i < neighborIndices.size(); i++) {
+		data.edges.emplace_back(graph->getActorId(neighborIndices[i]), neighborWeights[i]);
+	}
+	return data;
+}
+
+std::vector<int> ActorGraph::findIDsByName(std::string_view name) const {
+	//Exact matches rank first in the name search, so stop at the first name that differs
+	std::vector<int> ids;
+	for (const Actor& actor : graph->searchActorsByName(std::string(name))) {
+		if (actor.name.size() != name.size()) {
+			break;
 		}
-		std::cout << "Loading edges from the 'Actor_Edges' table...\n";
-		{
-			while (edgeQuery.executeStep()) {
-				int actor1ID = edgeQuery.getColumn(0).getInt();
-				int actor2ID = edgeQuery.getColumn(1).getInt();
-				int weight = edgeQuery.getColumn(2).getInt();
-				actorDataMap.at(actor1ID).edges.emplace_back(actor2ID, weight);
-				actorDataMap.at(actor2ID).edges.emplace_back(actor1ID, weight);
-				edgeCount++;
-			}
+		if (actor.name == name) {
+			ids.push_back(actor.id);
 		}
-		std::cout << std::format("Graph Loaded with {} actors and {} edges!\n", actorCount, edgeCount);
 	}
-	catch (const std::exception& e) {
-		std::cerr << std::format("Error during graph loading: {} \n", e.what());
-		throw;
+	return ids;
+}
+
+const Graph& ActorGraph::getGraph() const {
+	return *graph;
+}
+
+ActorGraph loadActorDataFromDB(SQLite::Database& db) {
+	auto graph = std::make_shared<Graph>();
+	graph->loadFromDatabase(db);
+	return ActorGraph(std::move(graph));
+}
+
+//Mapping the snapshot takes milliseconds, while stepping through SQLite takes a long while, so only fall back to it when needed
+Graph loadMainGraph() {
+	Graph graph;
+	if (graph.loadSnapshot(GRAPH_SNAPSHOT_PATH)) {
+		return graph;
+	}
+	std::cout << "No valid graph snapshot found, loading from the main database instead.\n";
+	SQLite::Database db = openMainDatabase();
+	graph.loadFromDatabase(db);
+	graph.reorder(MAIN_GRAPH_ORDER);
+	graph.saveSnapshot(GRAPH_SNAPSHOT_PATH);
+	return graph;
+}
+
+//Function local statics are initialized exactly once even with several threads asking at the same time
+GraphSnapshot getMainGraphSnapshot() {
+	static const GraphSnapshot mainGraph = std::make_shared<const Graph>(loadMainGraph());
+	return mainGraph;
+}
+
+//Building landmarks runs a full Dijkstra per landmark, so it is only done when the saved ones don't fit the graph
+LandmarkIndex loadMainLandmarks(const Graph& graph) {
+	LandmarkIndex landmarks;
+	if (landmarks.load(LANDMARKS_PATH, graph)) {
+		return landmarks;
+	}
+	std::cout << "No valid landmarks found, building them now.\n";
+	landmarks.build(graph);
+	landmarks.printStatistics();
+	landmarks.save(LANDMARKS_PATH);
+	return landmarks;
+}
+
+//The labels take a parallel BFS per actor to build, so the saved ones are used whenever they fit the graph
+HopLabelIndex loadMainHopLabels(const Graph& graph) {
+	HopLabelIndex labels;
+	if (labels.load(HOP_LABELS_PATH, graph)) {
+		return labels;
 	}
-	return allData;
+	std::cout << "No valid hop labels found, building them now.\n";
+	if (labels.build(graph)) {
+		labels.printStatistics();
+		labels.save(HOP_LABELS_PATH);
+	}
+	return labels;
+}
+
+//Contracting the graph takes minutes, so the saved hierarchy is used whenever it fits the graph
+ContractionHierarchy loadMainContractionHierarchy(const Graph& graph) {
+	ContractionHierarchy hierarchy;
+	if (hierarchy.load(HIERARCHY_PATH, graph)) {
+		return hierarchy;
+	}
+	std::cout << "No valid contraction hierarchy found, building it now.\n";
+	hierarchy.build(graph);
+	hierarchy.printStatistics();
+	hierarchy.save(HIERARCHY_PATH);
+	return hierarchy;
 }
 
 //=====================================================================================
@@ -150,6 +234,30 @@ bool mergeCollectionAndBuildGraph(SQLite::Database& mainDB, const std::vector<st
 		std::cerr << std::format("CRITICAL PROCESS FAILURE: Rollback executed. Error: {} \n", e.what());
 		return false;
 	}
+	//Save the binary snapshot of the new graph, so the next launches can skip SQLite entirely
+	try {
+		Graph graph;
+		graph.loadFromDatabase(mainDB);
+		graph.reorder(MAIN_GRAPH_ORDER);
+		if (!graph.saveSnapshot(GRAPH_SNAPSHOT_PATH)) {
+			std::cerr << "Graph snapshot could not be saved, the next launch will load from the database.\n";
+		}
+		//The old landmarks belong to the old graph, so rebuild them now rather than on the next launch
+		LandmarkIndex landmarks;
+		landmarks.build(graph);
+		landmarks.printStatistics();
+		if (!landmarks.save(LANDMARKS_PATH)) {
+			std::cerr << "Landmarks could not be saved, they will be rebuilt on the next launch.\n";
+		}
+		//The hop labels and contraction hierarchy take many minutes to build, so they are left to
+		//loadMainHopLabels/loadMainContractionHierarchy, the old files only describe the old graph
+		std::error_code removeError;
+		std::filesystem::remove(HOP_LABELS_PATH, removeError);
+		std::filesystem::remove(HIERARCHY_PATH, removeError);
+	}
+	catch (const std::exception& e) {
+		std::cerr << std::format("Graph snapshot failed: {} \n", e.what());
+	}
 	return true;
 }
 
@@ -193,120 +301,61 @@ void setupDatabase(SQLite::Database& db) {
 	}
 }
 
-//Now would work properly. Takes in the ID, Title, and Cast info, and saves it properly
-void saveMovieData(SQLite::Database& db, int movieID, const std::string& title, const json& castArray) {
-	db.exec("BEGIN TRANSACTION;");
-	try {
-		SQLite::Statement stmtMovie(db, "INSERT OR IGNORE INTO Movies (movie_id, title) VALUES (?, ?);");
-		SQLite::Statement stmtActor(db, "INSERT OR IGNORE INTO Actors (actor_id, actor_name) VALUES (?, ?);");
-		SQLite::Statement stmtLink(db, "INSERT INTO Cast_Links (movie_id, actor_id) VALUES (?, ?) ON CONFLICT DO NOTHING;");
-		stmtMovie.bind(1, movieID);
-		stmtMovie.bind(2, title);
-		stmtMovie.exec();
-		for (const auto& actor : castArray) {
-			int actorID = actor.value("id", -1);
-			std::string actorName = actor.value("name", "N/A");
-			if (actorID != -1) {
-				std::cout << "Saving Actor: " << actorName << " (ID: " << actorID << ") for Movie ID: " << movieID << std::endl;
-				stmtActor.bind(1, actorID);
-				stmtActor.bind(2, actorName);
-				stmtActor.exec();
-				stmtActor.reset();
-				stmtLink.bind(1, movieID);
-				stmtLink.bind(2, actorID);
-				stmtLink.exec(); // The Line that was forgoten, leading to a full recollection of cast list, but added for future use - Andrew
-				stmtLink.reset();
-			}
-		}
-		db.exec("COMMIT;");
+//Saving the parsed movies is done by MovieWriter (see movieWriter.h), which keeps its statements and transaction open for the whole year
+
+//Pulls the title and cast out of a fetched movie, returns false (after saying why) if there is no movie in it
+//Reads it with the streaming extractor (see tmdbParser.h), the full json DOM spent most of its time on the crew list
+bool parseMovieResponse(int movieID, const HttpResponse& response, MovieRecord& movie) {
+	if (response.body.empty()) {
+		std::cerr << std::format("API Request failed for Movie ID ({}): {}\n", movieID, response.error);
+		return false;
 	}
-	catch (const std::exception& e) {
-		db.exec("ROLLBACK;"); //Cancels Transaction
-		std::cerr << std::format("Database Transaction Failed (Movie ID {} ): {} \n", movieID, e.what());
+	MovieDetails details;
+	std::string error;
+	if (!extractMovieDetails(response.body, details, error)) {
+		std::cerr << std::format("JSON Parse Error for Movie ID ({}): {} \n", movieID, error);
+		return false;
 	}
-}
-
-//Saves movie to a Database, requires Movie ID and the Database to be specified
-void processMovie(SQLite::Database& db, int movieID) {
-	std::string movieURL = buildMovieURL(movieID);
-	std::this_thread::sleep_for(std::chrono::milliseconds(100)); //Speed :)
-	std::string movieResponse = curlRequest(movieURL);
-	try {
-		json movieData = json::parse(movieResponse);
-		if (movieData.contains("status_code")) {
-			if (movieData.value("status_code", 0) == 429) {
-				std::cout << "OOPS! Too fast!!!!\n";
-				std::this_thread::sleep_for(std::chrono::milliseconds(500)); //Not speed :(
-				movieURL = buildMovieURL(movieID);
-				movieResponse = curlRequest(movieURL);
-				movieData = json::parse(movieResponse);
-			}
-			else {
-				std::cerr << "API Request failed and could not restart!\n";
-				return;
-			}
+	if (details.statusCode) {
+		if (*details.statusCode == 429 || *details.statusCode == 25) { //25 is TMDB's own code for "request count is over the allowed limit"
+			//The fetcher already retried the HTTP 429s, so only slow down the rest
+			getTmdbRateLimiter().onRateLimited(0);
 		}
-		std::string title = movieData.value("title", "N/A");
-		json castArray = movieData.value("credits", json::object()).value("cast", json::array());
-		saveMovieData(db, movieID, title, castArray);
-	}
-	catch (json::parse_error& e) {
-		std::cerr << std::format("JSON Parse Error for Movie ID ({}): {} \n", movieID, e.what());
+		std::cerr << std::format("API Request for Movie ID ({}) failed and could not restart!\n", movieID);
+		return false;
 	}
+	movie.movieID = movieID;
+	movie.title = std::move(details.title);
+	movie.cast = std::move(details.cast);
+	return true;
 }
 
-//Gets the Movie IDs from the json Response, then sends it to be processed, if results are present, then returns 0, else, returns 1
-int extractMovieIDs(SQLite::Database& db, const std::string& jsonResponse) {
-	try {
-		json parsed = json::parse(jsonResponse);
-		if (!parsed.contains("results") || parsed["results"].empty()) {
-			return 1;
-		}
-		for (const auto& movie : parsed["results"]) {
-			if (movie.contains("id")) {
-				int movieID = movie["id"];
-				if (movieID != -1) {
-					processMovie(db, movieID);
-				}
-				else {
-					std::cerr << "Invalid movie ID found.\n";
-				}
-			}
-		}
+//Gets the Movie IDs from the json Response of a discover page, empty if there are no results left
+std::vector<int> extractMovieIDs(const std::string& jsonResponse) {
+	std::vector<int> movieIDs;
+	std::string error;
+	if (!extractDiscoverIds(jsonResponse, movieIDs, error)) {
+		std::cerr << std::format("JSON Parse Error: {}\n", error);
+		return movieIDs;
 	}
-	catch (json::parse_error& e) {
-		std::cerr << std::format("JSON Parse Error: {}\n", e.what());
-		return 1;
+	if (std::find(movieIDs.begin(), movieIDs.end(), -1) != movieIDs.end()) {
+		std::cerr << "Invalid movie ID found.\n";
+		std::erase(movieIDs, -1);
 	}
-	return 0;
+	return movieIDs;
 }
 
 //Initially went from 1900 to 2025. Now setup for 1 year at a time, and able to detect if there are less than 500 pages properly
+//Runs as a pipeline (see collectionPipeline.h), so fetching, parsing and saving all happen at the same time
 void runCollectionLoop(SQLite::Database& db,int year) {
 	std::cout << "\n==========================================================\n";
 	std::cout << "STARTING COLLECTION FOR YEAR: " << year << std::endl;
 	std::cout << "==========================================================\n";
-	int maxPages = 500;   //Default imit to 500 per year
-	//Now for the page loop
-	for (int page = 1; page <= maxPages; ++page) {
-		std::string url = buildDiscoverURL(page, year); //URL Production
-		std::cout << std::format("Fetching Page {} of year {}.\n", page, year);
-		std::string jsonResponse = curlRequest(url);
-		std::this_thread::sleep_for(std::chrono::milliseconds(100)); //Speed :)
-		if (jsonResponse.empty()) {
-			std::cerr << "Failed to retrieve page " << page << std::endl;
-			break;
-		}
-		try {
-			int stillResults = extractMovieIDs(db, jsonResponse);
-			if (stillResults == 1) {
-				break;
-			}
-		}
-		catch (const json::parse_error& e) {
-			std::cerr << std::format("JSON Parsing Error on page {} for year {}: {}\n", page, year, e.what());			}
-	}
-	std::cout << std::format("Data Collection for {} complete", year);
+	CollectionPipeline pipeline(db, getTmdbRateLimiter());
+	CollectionPipeline::Stats stats = pipeline.run(year);
+	std::cout << std::format("Data Collection for {} complete, {} movies ({} cast links) in {:.1f} seconds ({:.1f} movies/s, {} rate limited)\n",
+		year, stats.moviesWritten, stats.creditsWritten, stats.seconds,
+		stats.seconds > 0.0 ? stats.moviesWritten / stats.seconds : 0.0, getTmdbRateLimiter().getRateLimitedCount());
 }
 
 // Get's the total amount of unique actors in the database
@@ -329,37 +378,48 @@ int getTotalActors(SQLite::Database& db) {
 //=====================================================================================
 //=====================================================================================
 
-//Callback function to handle data
-size_t writeCallback(void* contents, size_t size, size_t nmemb, std::string* userp) {
-	size_t totalSize = size * nmemb;
-	userp->append((char*)contents, totalSize);
-	return totalSize;
+//One limiter for every request to TMDB, so all the fetchers together stay within the budget in assets/config.cfg
+RateLimiter& getTmdbRateLimiter() {
+	static RateLimiter limiter(Config::TMDB_REQUESTS_PER_SECOND);
+	return limiter;
 }
 
+//Single request, made on this thread's own fetcher so repeated calls reuse its connection
 std::string curlRequest(const std::string& url) {
-	CURL* curl;
-	CURLcode res;
-	std::string buffer;
-	curl = curl_easy_init();
-	if (curl) {
-		if (!(curl_version_info(CURLVERSION_NOW)->features & CURL_VERSION_SSL)) {
-			std::cerr << "\nFATAL cURL ERROR: SSL support is missing. Cannot use HTTPS. Ensure cURL is built with SCHANNEL or OpenSSL.\n";
-			curl_easy_cleanup(curl);
-			return "";
-		}
-		curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
-		curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, writeCallback);
-		curl_easy_setopt(curl, CURLOPT_WRITEDATA, &buffer);
-		res = curl_easy_perform(curl);
-		if (res != CURLE_OK) {
-			std::cerr << std::format("cURL failed: {}\n", curl_easy_strerror(res));
+	thread_local HttpFetcher fetcher(1);
+	fetcher.setRateLimiter(&getTmdbRateLimiter());
+	return fetcher.fetch(url).body;
+}
+
+//Saves real responses to run compareJsonExtraction on: the year's first discover page as discover_<year>.json,
+//and up to movieCount of its movies as movie_<id>.json
+void recordSampleResponses(int year, int movieCount, const std::string& directory) {
+	std::filesystem::create_directories(directory);
+	HttpFetcher fetcher;
+	fetcher.setRateLimiter(&getTmdbRateLimiter());
+
+	auto save = [&](const std::string& fileName, const std::string& body) {
+		std::ofstream file(std::filesystem::path(directory) / fileName, std::ios::binary);
+		file << body;
+	};
+
+	std::string discoverPage = fetcher.fetch(buildDiscoverURL(1, year)).body;
+	save(std::format("discover_{}.json", year), discoverPage);
+
+	std::vector<int> movieIDs = extractMovieIDs(discoverPage);
+	movieIDs.resize(std::min<size_t>(movieIDs.size(), std::max(0, movieCount)));
+	std::vector<std::string> urls;
+	for (int movieID : movieIDs) {
+		urls.push_back(buildMovieURL(movieID));
+	}
+	size_t saved = 0;
+	fetcher.fetchAll(urls, [&](size_t index, HttpResponse& response) {
+		if (response.ok()) {
+			save(std::format("movie_{}.json", movieIDs[index]), response.body);
+			saved++;
 		}
-		curl_easy_cleanup(curl);
-	} else {
-		std::cerr << "Failed to initialize CURL.\n";
-		buffer.clear(); 
-	}
-	return buffer;
+	});
+	std::cout << std::format("Recorded a discover page and {} movies for {} in {}\n", saved, year, directory);
 }
 
 //=====================================================================================
@@ -369,11 +429,11 @@ std::string curlRequest(const std::string& url) {
 //=====================================================================================
 
 std::string buildDiscoverURL(int pageNumber, int year) {
-	return std::format("https://api.themoviedb.org/3/discover/movie?api_key={}&include_adult=false&include_video=false&language=en-US&page={}&year={}", Config::TMDB_API_KEY, pageNumber, year);
+	return std::format("{}discover/movie?api_key={}&include_adult=false&include_video=false&language=en-US&page={}&year={}", Config::TMDB_BASE_URL, Config::TMDB_API_KEY, pageNumber, year);
 }
 
 std::string buildMovieURL(int movieID) {
-	return std::format("https://api.themoviedb.org/3/movie/{}?api_key={}&append_to_response=credits", std::to_string(movieID), Config::TMDB_API_KEY);
+	return std::format("{}movie/{}?api_key={}&append_to_response=credits", Config::TMDB_BASE_URL, std::to_string(movieID), Config::TMDB_API_KEY);
 }
 
 //Add Actor URL builder later here for image urls
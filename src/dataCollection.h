@@ -3,6 +3,7 @@
 
 // --- Libraries and Aliases ---
 #include <string>
+#include <string_view>
 #include <vector>
 #include <stdexcept>
 #include <filesystem>
@@ -11,6 +12,15 @@
 #include <SQLiteCpp/SQLiteCpp.h> 
 #include <nlohmann/json.hpp>
 
+#include "graph.h"
+#include "landmarks.h"
+#include "hopLabels.h"
+#include "contractionHierarchy.h"
+#include "httpFetcher.h"
+#include "rateLimiter.h"
+#include "movieWriter.h"
+#include "tmdbParser.h"
+
 // Easy alias for JSON
 using json = nlohmann::json;
 
@@ -36,24 +46,68 @@ struct yearStatus {
 //=====================================================================================
 //=====================================================================================
 
-//Struct for actors
+//Struct for actors, the name points into the graph it came from
 struct ActorData {
-	std::string name;
+	std::string_view name;
 	std::vector<std::pair<int, int>> edges; // pair is <actorID, weight>, for co actor edges.
 };
-using ActorGraph = std::pair<std::unordered_map<int, ActorData>, std::unordered_map<std::string, std::vector<int>>>;
-//Big data structure. First is the actorID with their data, second is actor names to a list of IDs, in case of duplicates.
 
+//Actor lookups by ID and by name, as a thin view over a shared graph snapshot.
+//This used to be a second copy of the whole graph in hash maps, loaded separately from the same database.
+//Now it only translates the graph's CSR arrays back to IDs when asked, so it costs nothing to create.
+class ActorGraph {
+public:
+	explicit ActorGraph(GraphSnapshot graph);
+
+	//Number of actors
+	size_t size() const;
+
+	//Whether the actor is in the graph
+	bool contains(int actorID) const;
+
+	//Name and co actor edges of an actor, throws std::out_of_range if it isn't in the graph
+	ActorData at(int actorID) const;
+
+	//IDs of every actor with exactly this name (several actors can share one)
+	std::vector<int> findIDsByName(std::string_view name) const;
+
+	//The graph being viewed, for running searches on it
+	const Graph& getGraph() const;
+
+private:
+	GraphSnapshot graph;
+};
+
+//Builds a graph from the database and views it, prefer getMainGraphSnapshot() to share the main one
 ActorGraph loadActorDataFromDB(SQLite::Database& db);
 
+//The main graph, loaded once (see loadMainGraph) on first use and then shared by every caller, from any thread
+GraphSnapshot getMainGraphSnapshot();
+
+//Loads the main graph, mapping the binary snapshot if it exists, otherwise building it from the main database (and saving the snapshot for next time)
+Graph loadMainGraph();
+
+//Loads the landmarks for the main graph (for A* strongest path searches), building and saving them if they are missing or out of date
+LandmarkIndex loadMainLandmarks(const Graph& graph);
+
+//Loads the hop label index for the main graph (for instant degrees of separation), building and saving it if it is missing or out of date
+HopLabelIndex loadMainHopLabels(const Graph& graph);
+
+//Loads the contraction hierarchy for the main graph (for fast strongest path searches), building and saving it if it is missing or out of date
+ContractionHierarchy loadMainContractionHierarchy(const Graph& graph);
+
 //=====================================================================================
 //=====================================================================================
 //								 	cURL Work
 //=====================================================================================
 //=====================================================================================
 
-size_t writeCallback(void* contents, size_t size, size_t nmemb, std::string* userp);
+//Requests go through HttpFetcher (see httpFetcher.h), which keeps connections open and runs many at once
 std::string curlRequest(const std::string& url);
+//The rate limiter every TMDB request waits on (see rateLimiter.h), shared by all threads
+RateLimiter& getTmdbRateLimiter();
+//Saves a discover page and some of its movies as .json files, the recorded responses compareJsonExtraction reads
+void recordSampleResponses(int year, int movieCount, const std::string& directory);
 
 //=====================================================================================
 //=====================================================================================
@@ -95,9 +149,8 @@ std::string buildMovieURL(int movieID);
 //=====================================================================================
 
 void setupDatabase(SQLite::Database& db);
-void saveMovieData(SQLite::Database& db, int movieID, const std::string& title, const json& castArray);
-void processMovie(SQLite::Database& db, int movieID);
-int extractMovieIDs(SQLite::Database& db, const std::string& jsonResponse);
+bool parseMovieResponse(int movieID, const HttpResponse& response, MovieRecord& movie);
+std::vector<int> extractMovieIDs(const std::string& jsonResponse);
 void runCollectionLoop(SQLite::Database& db, int year);
 
 //=====================================================================================
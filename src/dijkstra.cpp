@@ -1,126 +1,377 @@
 #include "dijkstra.h"
-#include <queue>
-#include <unordered_map>
-#include <unordered_set>
+#include "queryWorkspace.h"
+#include "landmarks.h"
+#include "contractionHierarchy.h"
 #include <limits>
 #include <iostream>
 #include <format>
 #include <cmath>
+#include <algorithm>
+#include <atomic>
+#include <barrier>
+#include <thread>
 
 //=====================================================================================
 //                          Dijkstra Implementation
 //=====================================================================================
 
-PathResult Dijkstra::findStrongestPath(const Graph& graph, int startActorId, int endActorId) {
+PathResult Dijkstra::findStrongestPath(const Graph& graph, int startActorId, int endActorId, QueueType queueType) {
     auto startTime = std::chrono::high_resolution_clock::now();
 
     PathResult result;
 
-    // Validate input
-    if (!graph.hasActor(startActorId)) {
-        std::cerr << std::format("Error: Start actor ID {} not found in graph.\n", startActorId);
+    int startIndex = -1;
+    int endIndex = -1;
+    if (resolvePathEnds(graph, startActorId, endActorId, startTime, result, startIndex, endIndex)) {
         return result;
     }
 
-    if (!graph.hasActor(endActorId)) {
-        std::cerr << std::format("Error: End actor ID {} not found in graph.\n", endActorId);
-        return result;
+    // Dijkstra's Algorithm with inverted weights, on this thread's reusable workspace
+    QueryWorkspace& workspace = QueryWorkspace::forThread();
+    workspace.beginQuery(graph.getActorCount());
+    int maxWeight = graph.getMaxWeight();
+
+    bool found = false;
+    switch (queueType) {
+    case QueueType::BinaryHeap:
+        found = runSearch(graph, workspace, workspace.binaryHeap, workspace.cost,
+            [maxWeight](int weight) { return weightToCost(weight, maxWeight); },
+            startIndex, endIndex, result.nodesExpanded);
+        break;
+    case QueueType::DaryHeap:
+        found = runSearch(graph, workspace, workspace.daryHeap, workspace.cost,
+            [maxWeight](int weight) { return weightToCost(weight, maxWeight); },
+            startIndex, endIndex, result.nodesExpanded);
+        break;
+    case QueueType::RadixHeap:
+        found = runSearch(graph, workspace, workspace.radixHeap, workspace.costUnits,
+            [maxWeight](int weight) { return weightToCostUnits(weight, maxWeight); },
+            startIndex, endIndex, result.nodesExpanded);
+        break;
     }
 
-    // Special case: start and end are the same
-    if (startActorId == endActorId) {
-        result.path.push_back(startActorId);
-        const Actor* actor = graph.getActor(startActorId);
-        if (actor) {
-            result.actorNames.push_back(actor->name);
-        }
-        result.hopCount = 0;
-        result.totalWeight = 0;
+    // Reconstruct path if found
+    if (found) {
+        result.path = reconstructPath(graph, workspace.parent, startIndex, endIndex);
         result.pathExists = true;
+        result.hopCount = static_cast<int>(result.path.size()) - 1;
+        result.totalWeight = calculatePathWeight(graph, result.path);
 
-        auto endTime = std::chrono::high_resolution_clock::now();
-        result.executionTimeMs = std::chrono::duration<double, std::milli>(endTime - startTime).count();
-
-        return result;
+        // Get actor names for the path
+        for (int actorId : result.path) {
+            result.actorNames.emplace_back(graph.getName(graph.getIndex(actorId)));
+        }
+    }
+    else {
+        std::cout << "No path found between the two actors.\n";
     }
 
-    // Dijkstra's Algorithm with inverted weights
-    std::priority_queue<Node, std::vector<Node>, std::greater<Node>> pq;
-    std::unordered_map<int, double> distance;
-    std::unordered_map<int, int> parent;
-    std::unordered_set<int> visited;
-
-    int maxWeight = graph.getMaxWeight();
+    auto endTime = std::chrono::high_resolution_clock::now();
+    result.executionTimeMs = std::chrono::duration<double, std::milli>(endTime - startTime).count();
 
-    // Initialize distances to infinity
-    distance[startActorId] = 0.0;
-    parent[startActorId] = -1;
-    pq.push(Node(startActorId, 0.0));
+    return result;
+}
 
-    bool found = false;
+template <typename Queue, typename Cost, typename EdgeCost>
+bool Dijkstra::runSearch(
+    const Graph& graph,
+    QueryWorkspace& workspace,
+    Queue& queue,
+    std::vector<Cost>& cost,
+    EdgeCost edgeCost,
+    int startIndex,
+    int endIndex,
+    int& nodesExpanded
+) {
+    // Actors count as infinitely far away until they are reached
+    QueryWorkspace::Stamps visited = workspace.stamps();
+    visited.markReached(startIndex);
+    cost[startIndex] = 0;
+    workspace.parent[startIndex] = -1;
+    queue.push(0, startIndex);
 
     // Dijkstra's main loop
-    while (!pq.empty()) {
-        Node current = pq.top();
-        pq.pop();
+    while (!queue.empty()) {
+        int currentIndex = queue.pop().second;
 
-        int currentActorId = current.actorId;
-
-        // Skip if already visited
-        if (visited.find(currentActorId) != visited.end()) {
+        // Skip if already visited (a stale entry of a lazy queue)
+        if (visited.isSettled(currentIndex)) {
             continue;
         }
 
-        visited.insert(currentActorId);
+        visited.markSettled(currentIndex);
 
         // Check if we reached the destination
-        if (currentActorId == endActorId) {
-            found = true;
-            break;
+        if (currentIndex == endIndex) {
+            return true;
         }
 
         // Explore all neighbors
-        const std::vector<Edge>* neighbors = graph.getNeighbors(currentActorId);
-        if (neighbors == nullptr) {
-            continue;
-        }
+        nodesExpanded++;
+        std::span<const int> neighborIndices = graph.getNeighborIndices(currentIndex);
+        std::span<const int> neighborWeights = graph.getNeighborWeights(currentIndex);
 
-        for (const Edge& edge : *neighbors) {
-            int neighborId = edge.targetActorId;
+        for (size_t i = 0; i < neighborIndices.size(); i++) {
+            int neighborIndex = neighborIndices[i];
 
             // Skip if already visited
-            if (visited.find(neighborId) != visited.end()) {
+            if (visited.isSettled(neighborIndex)) {
                 continue;
             }
 
             // Calculate cost for this edge (inverted weight)
-            double edgeCost = weightToCost(edge.weight, maxWeight);
-            double newDistance = distance[currentActorId] + edgeCost;
+            Cost newDistance = cost[currentIndex] + edgeCost(neighborWeights[i]);
 
             // If we found a better path to this neighbor
-            if (distance.find(neighborId) == distance.end() || newDistance < distance[neighborId]) {
-                distance[neighborId] = newDistance;
-                parent[neighborId] = currentActorId;
-                pq.push(Node(neighborId, newDistance));
+            if (!visited.isReached(neighborIndex) || newDistance < cost[neighborIndex]) {
+                visited.markReached(neighborIndex);
+                cost[neighborIndex] = newDistance;
+                workspace.parent[neighborIndex] = currentIndex;
+                queue.push(newDistance, neighborIndex);
             }
         }
     }
 
+    return false;
+}
+
+//=====================================================================================
+//                          A* with Landmarks
+//=====================================================================================
+
+PathResult Dijkstra::findStrongestPathAStar(
+    const Graph& graph,
+    const LandmarkIndex& landmarks,
+    int startActorId,
+    int endActorId
+) {
+    if (!landmarks.matches(graph)) {
+        std::cerr << "Warning: Landmarks were not built for this graph, using plain Dijkstra instead.\n";
+        return findStrongestPath(graph, startActorId, endActorId);
+    }
+
+    auto startTime = std::chrono::high_resolution_clock::now();
+
+    PathResult result;
+
+    int startIndex = -1;
+    int endIndex = -1;
+    if (resolvePathEnds(graph, startActorId, endActorId, startTime, result, startIndex, endIndex)) {
+        return result;
+    }
+
+    // An infinite bound means a landmark reaches only one of the two, so there's nothing to search
+    // Otherwise both sides share the average potential (bound to the end - bound to the start) / 2,
+    // which keeps every edge's reduced cost non-negative from both directions
+    int meetFrom = -1;
+    int meetTo = -1;
+    if (landmarks.lowerBound(startIndex, endIndex) != LandmarkIndex::INFINITE_COST) {
+        runBidirectional(graph, startIndex, endIndex,
+            [&landmarks, startIndex, endIndex](int index) {
+                return 0.5 * (landmarks.lowerBound(index, endIndex) - landmarks.lowerBound(index, startIndex));
+            },
+            result.nodesExpanded, meetFrom, meetTo);
+    }
+
     // Reconstruct path if found
-    if (found) {
-        result.path = reconstructPath(parent, startActorId, endActorId);
+    if (meetFrom != -1) {
+        result.path = reconstructBidirectionalPath(graph, startIndex, meetFrom, meetTo, endIndex);
         result.pathExists = true;
         result.hopCount = static_cast<int>(result.path.size()) - 1;
         result.totalWeight = calculatePathWeight(graph, result.path);
 
         // Get actor names for the path
         for (int actorId : result.path) {
-            const Actor* actor = graph.getActor(actorId);
-            if (actor) {
-                result.actorNames.push_back(actor->name);
+            result.actorNames.emplace_back(graph.getName(graph.getIndex(actorId)));
+        }
+    }
+    else {
+        std::cout << "No path found between the two actors.\n";
+    }
+
+    auto endTime = std::chrono::high_resolution_clock::now();
+    result.executionTimeMs = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+
+    return result;
+}
+
+//=====================================================================================
+//                          Contraction Hierarchy Query
+//=====================================================================================
+
+PathResult Dijkstra::findStrongestPathCH(
+    const Graph& graph,
+    const ContractionHierarchy& hierarchy,
+    int startActorId,
+    int endActorId
+) {
+    if (!hierarchy.matches(graph)) {
+        std::cerr << "Warning: Contraction hierarchy was not built for this graph, using plain Dijkstra instead.\n";
+        return findStrongestPath(graph, startActorId, endActorId);
+    }
+
+    auto startTime = std::chrono::high_resolution_clock::now();
+
+    PathResult result;
+
+    int startIndex = -1;
+    int endIndex = -1;
+    if (resolvePathEnds(graph, startActorId, endActorId, startTime, result, startIndex, endIndex)) {
+        return result;
+    }
+
+    // Phase 1: an upward search from each end on workspace slots 0 and 1, run to the end (they
+    // only climb through contracted actors, so they stay small). Core actors are reached but not
+    // expanded, they're where the second phase starts from. Upward costs aren't real distances,
+    // so an actor settled by both sides is only a candidate meeting point.
+    QueryWorkspace* sides[2] = { &QueryWorkspace::forThread(0), &QueryWorkspace::forThread(1) };
+    QueryWorkspace::Stamps visited[2];
+    std::vector<int> coreEntries[2];
+    int roots[2] = { startIndex, endIndex };
+
+    double bestCost = std::numeric_limits<double>::infinity();
+    int meetFrom = -1;
+    int meetTo = -1;
+
+    for (int side = 0; side < 2; side++) {
+        QueryWorkspace& current = *sides[side];
+        current.beginQuery(graph.getActorCount());
+        visited[side] = current.stamps();
+        visited[side].markReached(roots[side]);
+        current.cost[roots[side]] = 0.0;
+        current.parent[roots[side]] = -1;
+        current.daryHeap.push(0.0, roots[side]);
+
+        while (!current.daryHeap.empty()) {
+            int currentIndex = current.daryHeap.pop().second;
+            double currentCost = current.cost[currentIndex];
+
+            // Side 0 is already finished, so its cost here is final
+            if (side == 1 && visited[0].isReached(currentIndex) && currentCost + sides[0]->cost[currentIndex] < bestCost) {
+                bestCost = currentCost + sides[0]->cost[currentIndex];
+                meetFrom = currentIndex;
+                meetTo = currentIndex;
+            }
+
+            if (hierarchy.isCore(currentIndex)) {
+                coreEntries[side].push_back(currentIndex);
+                continue;
+            }
+            visited[side].markSettled(currentIndex);
+
+            std::span<const int> upTargets = hierarchy.getUpwardTargets(currentIndex);
+            std::span<const double> upCosts = hierarchy.getUpwardCosts(currentIndex);
+
+            // Stall on demand: if a higher actor already reaches this one more cheaply (going back
+            // down an upward edge), it isn't on a strongest upward path and needn't be expanded
+            bool stalled = false;
+            for (size_t i = 0; i < upTargets.size(); i++) {
+                if (visited[side].isReached(upTargets[i]) && current.cost[upTargets[i]] + upCosts[i] < currentCost) {
+                    stalled = true;
+                    break;
+                }
+            }
+            if (stalled) {
+                continue;
+            }
+
+            result.nodesExpanded++;
+            for (size_t i = 0; i < upTargets.size(); i++) {
+                int neighborIndex = upTargets[i];
+                if (visited[side].isSettled(neighborIndex)) {
+                    continue;
+                }
+
+                double newDistance = currentCost + upCosts[i];
+                if (!visited[side].isReached(neighborIndex) || newDistance < current.cost[neighborIndex]) {
+                    visited[side].markReached(neighborIndex);
+                    current.cost[neighborIndex] = newDistance;
+                    current.parent[neighborIndex] = currentIndex;
+                    current.daryHeap.push(newDistance, neighborIndex);
+                }
             }
         }
     }
+
+    // Phase 2: the core keeps its edges in both directions, so from the core entries on it's a
+    // plain bidirectional Dijkstra (as in runBidirectional), stopping once the two queue heads
+    // together cost at least as much as the best path found
+    for (int side = 0; side < 2; side++) {
+        for (int entry : coreEntries[side]) {
+            sides[side]->daryHeap.push(sides[side]->cost[entry], entry);
+        }
+    }
+
+    while (!sides[0]->daryHeap.empty() && !sides[1]->daryHeap.empty()) {
+        double head0 = sides[0]->daryHeap.top().first;
+        double head1 = sides[1]->daryHeap.top().first;
+        if (head0 + head1 >= bestCost) {
+            break;
+        }
+
+        int side = head0 <= head1 ? 0 : 1;
+        QueryWorkspace& current = *sides[side];
+        const QueryWorkspace& other = *sides[1 - side];
+        int currentIndex = current.daryHeap.pop().second;
+        visited[side].markSettled(currentIndex);
+        double currentCost = current.cost[currentIndex];
+
+        result.nodesExpanded++;
+        std::span<const int> coreTargets = hierarchy.getUpwardTargets(currentIndex);
+        std::span<const double> coreCosts = hierarchy.getUpwardCosts(currentIndex);
+        for (size_t i = 0; i < coreTargets.size(); i++) {
+            int neighborIndex = coreTargets[i];
+            double newDistance = currentCost + coreCosts[i];
+
+            // Reaching the other search gives a candidate path
+            if (visited[1 - side].isReached(neighborIndex)) {
+                double pathCost = newDistance + other.cost[neighborIndex];
+                if (pathCost < bestCost) {
+                    bestCost = pathCost;
+                    meetFrom = side == 0 ? currentIndex : neighborIndex;
+                    meetTo = side == 0 ? neighborIndex : currentIndex;
+                }
+            }
+
+            if (visited[side].isSettled(neighborIndex)) {
+                continue;
+            }
+
+            if (!visited[side].isReached(neighborIndex) || newDistance < current.cost[neighborIndex]) {
+                visited[side].markReached(neighborIndex);
+                current.cost[neighborIndex] = newDistance;
+                current.parent[neighborIndex] = currentIndex;
+                current.daryHeap.push(newDistance, neighborIndex);
+            }
+        }
+    }
+
+    // Reconstruct path if found: start -> meetFrom -> meetTo -> end in hierarchy edges (meetFrom and
+    // meetTo are the same actor when the searches met in phase 1), each unpacked into real edges
+    if (meetFrom != -1) {
+        std::vector<int> hierarchyPath;
+        for (int current = meetFrom; current != -1; current = sides[0]->parent[current]) {
+            hierarchyPath.push_back(current);
+        }
+        std::reverse(hierarchyPath.begin(), hierarchyPath.end());
+        int current = meetTo == meetFrom ? sides[1]->parent[meetTo] : meetTo;
+        for (; current != -1; current = sides[1]->parent[current]) {
+            hierarchyPath.push_back(current);
+        }
+
+        std::vector<int> indexPath = { startIndex };
+        for (size_t i = 0; i + 1 < hierarchyPath.size(); i++) {
+            hierarchy.unpackEdge(hierarchyPath[i], hierarchyPath[i + 1], indexPath);
+        }
+
+        for (int index : indexPath) {
+            result.path.push_back(graph.getActorId(index));
+            result.actorNames.emplace_back(graph.getName(index));
+        }
+        result.pathExists = true;
+        result.hopCount = static_cast<int>(result.path.size()) - 1;
+        result.totalWeight = calculatePathWeight(graph, result.path);
+    }
     else {
         std::cout << "No path found between the two actors.\n";
     }
@@ -131,28 +382,412 @@ PathResult Dijkstra::findStrongestPath(const Graph& graph, int startActorId, int
     return result;
 }
 
+//=====================================================================================
+//                          Cost Tables
+//=====================================================================================
+
+CostTable Dijkstra::computeCostTable(const Graph& graph, int startActorId) {
+    auto startTime = std::chrono::high_resolution_clock::now();
+
+    CostTable table;
+    table.sourceActorId = startActorId;
+
+    int startIndex = graph.getIndex(startActorId);
+    if (startIndex == -1) {
+        std::cerr << std::format("Error: Start actor ID {} not found in graph.\n", startActorId);
+        return table;
+    }
+
+    // No target, so the search settles the whole component
+    QueryWorkspace& workspace = QueryWorkspace::forThread();
+    workspace.beginQuery(graph.getActorCount());
+    int maxWeight = graph.getMaxWeight();
+    int nodesExpanded = 0;
+    runSearch(graph, workspace, workspace.daryHeap, workspace.cost,
+        [maxWeight](int weight) { return weightToCost(weight, maxWeight); },
+        startIndex, -1, nodesExpanded);
+
+    // Copy the reached part of the workspace out into the table
+    QueryWorkspace::Stamps visited = workspace.stamps();
+    table.cost.assign(graph.getActorCount(), std::numeric_limits<double>::infinity());
+    table.parent.assign(graph.getActorCount(), -1);
+    for (int index = 0; index < static_cast<int>(graph.getActorCount()); index++) {
+        if (visited.isReached(index)) {
+            table.cost[index] = workspace.cost[index];
+            table.parent[index] = workspace.parent[index];
+            table.reachableCount++;
+        }
+    }
+
+    auto endTime = std::chrono::high_resolution_clock::now();
+    table.executionTimeMs = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+
+    return table;
+}
+
+//=====================================================================================
+//                          Delta-Stepping
+//=====================================================================================
+
+CostTable Dijkstra::computeCostTableParallel(const Graph& graph, int startActorId, double bucketWidth, unsigned int threadCount) {
+    auto startTime = std::chrono::high_resolution_clock::now();
+
+    // Items a thread takes at a time from the bucket being emptied
+    constexpr size_t CHUNK_SIZE = 64;
+
+    CostTable table;
+    table.sourceActorId = startActorId;
+
+    int startIndex = graph.getIndex(startActorId);
+    if (startIndex == -1) {
+        std::cerr << std::format("Error: Start actor ID {} not found in graph.\n", startActorId);
+        return table;
+    }
+
+    if (bucketWidth <= 0.0) {
+        bucketWidth = DEFAULT_BUCKET_WIDTH;
+    }
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    // Edge costs by weight, so the inner loops don't divide
+    const size_t actorCount = graph.getActorCount();
+    int maxWeight = graph.getMaxWeight();
+    std::vector<double> weightCost(maxWeight + 1);
+    for (int weight = 0; weight <= maxWeight; weight++) {
+        weightCost[weight] = weightToCost(weight, maxWeight);
+    }
+
+    table.cost.assign(actorCount, std::numeric_limits<double>::infinity());
+    table.parent.assign(actorCount, -1);
+    std::vector<double>& cost = table.cost;
+    cost[startIndex] = 0.0;
+
+    // Every thread keeps its own buckets of the actors whose cost it lowered (stale entries are
+    // skipped when the bucket comes up), and its own list of the actors it settled
+    std::vector<std::vector<std::vector<int>>> buckets(threadCount);
+    std::vector<std::vector<int>> settledBy(threadCount);
+    buckets[0].resize(1);
+    buckets[0][0].push_back(startIndex);
+
+    // Round an actor was last expanded in, so duplicates within one round are only expanded once,
+    // and whether its outgoing heavy edges are already due
+    std::vector<std::uint32_t> expandedRound(actorCount, 0);
+    std::vector<std::uint8_t> settled(actorCount, 0);
+
+    auto bucketOf = [bucketWidth](double value) {
+        return static_cast<size_t>(value / bucketWidth);
+    };
+
+    // Lower the cost of an actor if newCost beats it, queueing it in the thread's own bucket
+    auto relax = [&](unsigned int t, int index, double newCost) {
+        std::atomic_ref<double> target(cost[index]);
+        double current = target.load(std::memory_order_relaxed);
+        while (newCost < current) {
+            if (target.compare_exchange_weak(current, newCost, std::memory_order_relaxed)) {
+                size_t bucket = bucketOf(newCost);
+                if (buckets[t].size() <= bucket) {
+                    buckets[t].resize(bucket + 1);
+                }
+                buckets[t][bucket].push_back(index);
+                return;
+            }
+        }
+    };
+
+    // What the threads do until the next barrier: expand the current bucket along light
+    // edges, or expand everything it settled along heavy edges
+    enum class Phase { Light, Heavy, Done };
+    Phase phase = Phase::Heavy;
+    size_t currentBucket = 0;
+    bool started = false;
+    std::uint32_t round = 0;
+    std::vector<int> work;
+    std::atomic<size_t> nextChunk(0);
+
+    // Runs on one thread while all the others wait at the barrier: gathers the next work list
+    auto nextPhase = [&]() noexcept {
+        if (phase == Phase::Heavy) {
+            // Move on to the lowest bucket any thread still has entries in
+            size_t lowest = std::numeric_limits<size_t>::max();
+            for (const auto& own : buckets) {
+                for (size_t bucket = started ? currentBucket + 1 : 0; bucket < std::min(own.size(), lowest); bucket++) {
+                    if (!own[bucket].empty()) {
+                        lowest = bucket;
+                        break;
+                    }
+                }
+            }
+            started = true;
+            if (lowest == std::numeric_limits<size_t>::max()) {
+                phase = Phase::Done;
+                return;
+            }
+            currentBucket = lowest;
+        }
+
+        work.clear();
+        for (auto& own : buckets) {
+            if (currentBucket < own.size()) {
+                work.insert(work.end(), own[currentBucket].begin(), own[currentBucket].end());
+                own[currentBucket].clear();
+            }
+        }
+
+        if (!work.empty()) {
+            phase = Phase::Light;
+            round++;
+        }
+        else {
+            // The bucket stayed empty, so everything it settled is final
+            for (auto& own : settledBy) {
+                work.insert(work.end(), own.begin(), own.end());
+                own.clear();
+            }
+            phase = Phase::Heavy;
+        }
+        nextChunk.store(0, std::memory_order_relaxed);
+    };
+    nextPhase();
+    std::barrier phaseDone(threadCount, nextPhase);
+
+    auto worker = [&](unsigned int t) {
+        while (phase != Phase::Done) {
+            for (size_t chunk = nextChunk.fetch_add(CHUNK_SIZE, std::memory_order_relaxed);
+                chunk < work.size();
+                chunk = nextChunk.fetch_add(CHUNK_SIZE, std::memory_order_relaxed)) {
+                size_t chunkEnd = std::min(chunk + CHUNK_SIZE, work.size());
+                for (size_t i = chunk; i < chunkEnd; i++) {
+                    int current = work[i];
+                    double currentCost = std::atomic_ref<double>(cost[current]).load(std::memory_order_relaxed);
+                    bool light = phase == Phase::Light;
+
+                    if (light) {
+                        // Skip stale entries (its cost has since dropped into an earlier bucket) and repeats
+                        if (bucketOf(currentCost) != currentBucket ||
+                            std::atomic_ref<std::uint32_t>(expandedRound[current]).exchange(round, std::memory_order_relaxed) == round) {
+                            continue;
+                        }
+                        if (std::atomic_ref<std::uint8_t>(settled[current]).exchange(1, std::memory_order_relaxed) == 0) {
+                            settledBy[t].push_back(current);
+                        }
+                    }
+
+                    std::span<const int> neighborIndices = graph.getNeighborIndices(current);
+                    std::span<const int> neighborWeights = graph.getNeighborWeights(current);
+                    for (size_t n = 0; n < neighborIndices.size(); n++) {
+                        double edgeCost = weightCost[neighborWeights[n]];
+                        if ((edgeCost <= bucketWidth) == light) {
+                            relax(t, neighborIndices[n], currentCost + edgeCost);
+                        }
+                    }
+                }
+            }
+            phaseDone.arrive_and_wait();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned int t = 1; t < threadCount; t++) {
+        threads.emplace_back(worker, t);
+    }
+    worker(0);
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    // Every cost is final now, so the parent is the first neighbor the cost adds up through
+    // (or the cheapest one, should rounding keep them all from adding up exactly)
+    std::atomic<size_t> nextParentChunk(0);
+    auto findParents = [&]() {
+        constexpr size_t PARENT_CHUNK_SIZE = 4096;
+        for (size_t chunk = nextParentChunk.fetch_add(PARENT_CHUNK_SIZE);
+            chunk < actorCount;
+            chunk = nextParentChunk.fetch_add(PARENT_CHUNK_SIZE)) {
+            for (size_t index = chunk; index < std::min(chunk + PARENT_CHUNK_SIZE, actorCount); index++) {
+                if (cost[index] == std::numeric_limits<double>::infinity() || static_cast<int>(index) == startIndex) {
+                    continue;
+                }
+                std::span<const int> neighborIndices = graph.getNeighborIndices(static_cast<int>(index));
+                std::span<const int> neighborWeights = graph.getNeighborWeights(static_cast<int>(index));
+                double best = std::numeric_limits<double>::infinity();
+                for (size_t n = 0; n < neighborIndices.size(); n++) {
+                    double through = cost[neighborIndices[n]] + weightCost[neighborWeights[n]];
+                    if (through < best) {
+                        best = through;
+                        table.parent[index] = neighborIndices[n];
+                        if (through == cost[index]) {
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+    };
+    threads.clear();
+    for (unsigned int t = 1; t < threadCount; t++) {
+        threads.emplace_back(findParents);
+    }
+    findParents();
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    table.reachableCount = std::count_if(cost.begin(), cost.end(),
+        [](double value) { return value != std::numeric_limits<double>::infinity(); });
+
+    auto endTime = std::chrono::high_resolution_clock::now();
+    table.executionTimeMs = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+
+    return table;
+}
+
+//=====================================================================================
+//                          Bidirectional Dijkstra
+//=====================================================================================
+
+PathResult Dijkstra::findStrongestPathBidirectional(const Graph& graph, int startActorId, int endActorId) {
+    auto startTime = std::chrono::high_resolution_clock::now();
+
+    PathResult result;
+
+    int startIndex = -1;
+    int endIndex = -1;
+    if (resolvePathEnds(graph, startActorId, endActorId, startTime, result, startIndex, endIndex)) {
+        return result;
+    }
+
+    int meetFrom = -1;
+    int meetTo = -1;
+    runBidirectional(graph, startIndex, endIndex, [](int) { return 0.0; }, result.nodesExpanded, meetFrom, meetTo);
+
+    // Reconstruct path if found
+    if (meetFrom != -1) {
+        result.path = reconstructBidirectionalPath(graph, startIndex, meetFrom, meetTo, endIndex);
+        result.pathExists = true;
+        result.hopCount = static_cast<int>(result.path.size()) - 1;
+        result.totalWeight = calculatePathWeight(graph, result.path);
+
+        // Get actor names for the path
+        for (int actorId : result.path) {
+            result.actorNames.emplace_back(graph.getName(graph.getIndex(actorId)));
+        }
+    }
+    else {
+        std::cout << "No path found between the two actors.\n";
+    }
+
+    auto endTime = std::chrono::high_resolution_clock::now();
+    result.executionTimeMs = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+
+    return result;
+}
+
+template <typename Potential>
+bool Dijkstra::runBidirectional(
+    const Graph& graph,
+    int startIndex,
+    int endIndex,
+    Potential potential,
+    int& nodesExpanded,
+    int& meetFrom,
+    int& meetTo
+) {
+    // One search from each end on its own workspace, side 0 grows from the start and side 1 from the end
+    // The graph is undirected, so both sides walk the same adjacency lists
+    // Side 0 queues actors by cost + potential, side 1 by cost - potential
+    QueryWorkspace* sides[2] = { &QueryWorkspace::forThread(0), &QueryWorkspace::forThread(1) };
+    QueryWorkspace::Stamps visited[2];
+    int roots[2] = { startIndex, endIndex };
+    double signs[2] = { 1.0, -1.0 };
+    int maxWeight = graph.getMaxWeight();
+
+    for (int side = 0; side < 2; side++) {
+        sides[side]->beginQuery(graph.getActorCount());
+        visited[side] = sides[side]->stamps();
+        visited[side].markReached(roots[side]);
+        sides[side]->cost[roots[side]] = 0.0;
+        sides[side]->parent[roots[side]] = -1;
+        sides[side]->daryHeap.push(signs[side] * potential(roots[side]), roots[side]);
+    }
+
+    // Cheapest path through a meeting edge so far (meetFrom is reached by side 0, meetTo by side 1)
+    double bestCost = std::numeric_limits<double>::infinity();
+    meetFrom = -1;
+    meetTo = -1;
+
+    // An empty queue means that side has settled its whole component, so nothing better is left
+    while (!sides[0]->daryHeap.empty() && !sides[1]->daryHeap.empty()) {
+        double head0 = sides[0]->daryHeap.top().first;
+        double head1 = sides[1]->daryHeap.top().first;
+
+        // Any path not found yet costs at least both heads together (the potentials cancel out)
+        if (head0 + head1 >= bestCost) {
+            break;
+        }
+
+        // Settle one actor on the side with the cheaper head
+        int side = head0 <= head1 ? 0 : 1;
+        QueryWorkspace& current = *sides[side];
+        const QueryWorkspace& other = *sides[1 - side];
+        int currentIndex = current.daryHeap.pop().second;
+        visited[side].markSettled(currentIndex);
+
+        nodesExpanded++;
+        std::span<const int> neighborIndices = graph.getNeighborIndices(currentIndex);
+        std::span<const int> neighborWeights = graph.getNeighborWeights(currentIndex);
+
+        for (size_t i = 0; i < neighborIndices.size(); i++) {
+            int neighborIndex = neighborIndices[i];
+            double newDistance = current.cost[currentIndex] + weightToCost(neighborWeights[i], maxWeight);
+
+            // Reaching the other search gives a candidate path
+            if (visited[1 - side].isReached(neighborIndex)) {
+                double pathCost = newDistance + other.cost[neighborIndex];
+                if (pathCost < bestCost) {
+                    bestCost = pathCost;
+                    meetFrom = side == 0 ? currentIndex : neighborIndex;
+                    meetTo = side == 0 ? neighborIndex : currentIndex;
+                }
+            }
+
+            if (visited[side].isSettled(neighborIndex)) {
+                continue;
+            }
+
+            if (!visited[side].isReached(neighborIndex) || newDistance < current.cost[neighborIndex]) {
+                visited[side].markReached(neighborIndex);
+                current.cost[neighborIndex] = newDistance;
+                current.parent[neighborIndex] = currentIndex;
+                current.daryHeap.push(newDistance + signs[side] * potential(neighborIndex), neighborIndex);
+            }
+        }
+    }
+
+    return meetFrom != -1;
+}
+
 //=====================================================================================
 //                          Helper Methods
 //=====================================================================================
 
 std::vector<int> Dijkstra::reconstructPath(
-    const std::unordered_map<int, int>& parent,
-    int startActorId,
-    int endActorId
+    const Graph& graph,
+    const std::vector<int>& parent,
+    int startIndex,
+    int endIndex
 ) {
     std::vector<int> path;
-    int current = endActorId;
+    int current = endIndex;
 
     // Trace back from end to start
     while (current != -1) {
-        path.push_back(current);
-        auto it = parent.find(current);
-        if (it != parent.end()) {
-            current = it->second;
-        }
-        else {
+        path.push_back(graph.getActorId(current));
+        if (current == startIndex) {
             break;
         }
+        current = parent[current];
     }
 
     // Reverse to get path from start to end
@@ -161,17 +796,46 @@ std::vector<int> Dijkstra::reconstructPath(
     return path;
 }
 
+std::vector<int> Dijkstra::reconstructBidirectionalPath(
+    const Graph& graph,
+    int startIndex,
+    int meetFrom,
+    int meetTo,
+    int endIndex
+) {
+    // start -> meetFrom from side 0, then meetTo -> end from side 1
+    std::vector<int> path = reconstructPath(graph, QueryWorkspace::forThread(0).parent, startIndex, meetFrom);
+    const std::vector<int>& endParent = QueryWorkspace::forThread(1).parent;
+    for (int current = meetTo; current != -1; current = endParent[current]) {
+        path.push_back(graph.getActorId(current));
+        if (current == endIndex) {
+            break;
+        }
+    }
+    return path;
+}
+
 int Dijkstra::calculatePathWeight(const Graph& graph, const std::vector<int>& path) {
     int totalWeight = 0;
 
-    for (size_t i = 0; i < path.size() - 1; i++) {
-        int weight = graph.getEdgeWeight(path[i], path[i + 1]);
+    for (int weight : graph.getEdgeWeights(pathHops(graph, path))) {
         totalWeight += weight;
     }
 
     return totalWeight;
 }
 
+double Dijkstra::calculatePathCost(const Graph& graph, const std::vector<int>& path) {
+    int maxWeight = graph.getMaxWeight();
+    double totalCost = 0.0;
+
+    for (int weight : graph.getEdgeWeights(pathHops(graph, path))) {
+        totalCost += weightToCost(weight, maxWeight);
+    }
+
+    return totalCost;
+}
+
 double Dijkstra::weightToCost(int weight, int maxWeight) {
     // Invert the weight: higher weight (more collaborations) = lower cost
     // We use: cost = 1 / (weight + 1) to avoid division by zero
@@ -184,6 +848,10 @@ double Dijkstra::weightToCost(int weight, int maxWeight) {
     // return static_cast<double>(maxWeight - weight + 1);
 }
 
+std::uint64_t Dijkstra::weightToCostUnits(int weight, int maxWeight) {
+    return static_cast<std::uint64_t>(weightToCost(weight, maxWeight) * COST_UNIT_SCALE + 0.5);
+}
+
 void Dijkstra::printPath(const PathResult& result) {
     std::cout << "\n=== Dijkstra Path Result ===\n";
 
@@ -196,6 +864,7 @@ void Dijkstra::printPath(const PathResult& result) {
     std::cout << std::format("Path Length: {} degrees of separation\n", result.hopCount);
     std::cout << std::format("Total Collaboration Weight: {}\n", result.totalWeight);
     std::cout << std::format("Execution Time: {:.3f} ms\n", result.executionTimeMs);
+    std::cout << std::format("Actors Expanded: {}\n", result.nodesExpanded);
     std::cout << "\nPath (through strongest collaborations):\n";
 
     for (size_t i = 0; i < result.actorNames.size(); i++) {
@@ -4,6 +4,28 @@
 #include "graph.h"
 #include "bfh.h"  // Reuse PathResult structure
 #include <vector>
+#include <cstdint>
+
+class QueryWorkspace;
+class LandmarkIndex;
+class ContractionHierarchy;
+
+//=====================================================================================
+//                          Cost Table Structure
+//=====================================================================================
+// Strongest-path costs from one actor to every actor in the graph
+// Both arrays are indexed by dense graph index
+struct CostTable {
+    int sourceActorId;
+    std::vector<double> cost;            // Inverted-weight cost from the source, infinity if unreachable
+    std::vector<int> parent;             // Previous index on a strongest path, -1 for the source/unreachable
+    size_t reachableCount;               // Actors reached, including the source
+    double executionTimeMs;              // Time taken to build the table (milliseconds)
+
+    CostTable()
+        : sourceActorId(-1), reachableCount(0), executionTimeMs(0.0) {
+    }
+};
 
 //=====================================================================================
 //                          Dijkstra Class
@@ -11,42 +33,148 @@
 // Implements Dijkstra's Algorithm to find the path with strongest collaborations
 // Uses inverted weights: higher collaboration count = lower cost
 // This finds the path that maximizes total collaboration strength
+// Runs on the dense CSR indices of the graph, IDs are only used for input and output
 class Dijkstra {
 public:
+    // Priority queue used by the search (see priorityQueues.h), all give equally strong paths
+    // compareDijkstraModes() times them on the real graph, the 4-ary heap is the default
+    // since it came out fastest there (about 17% faster than the binary heap)
+    enum class QueueType {
+        BinaryHeap,     // std::push_heap/pop_heap with stale entries, the original queue
+        DaryHeap,       // Indexed 4-ary heap with decrease-key, no stale entries
+        RadixHeap       // Radix heap over costs quantized to integers (COST_UNIT_SCALE per 1.0 of cost)
+    };
+
     // Find path with strongest collaborations from startActorId to endActorId
     // Returns PathResult with the path information
-    static PathResult findStrongestPath(const Graph& graph, int startActorId, int endActorId);
+    static PathResult findStrongestPath(
+        const Graph& graph,
+        int startActorId,
+        int endActorId,
+        QueueType queueType = QueueType::DaryHeap
+    );
+
+    // Same query, but searching from both actors at once: each step settles one actor on
+    // whichever side has the cheaper queue head, and every edge into the other side's
+    // search is a candidate path. Stops once the two queue heads together cost at least
+    // as much as the best candidate, which is then as strong as the one-sided search's path.
+    // Settles far fewer actors, the two searches only cover about "half the distance" each.
+    static PathResult findStrongestPathBidirectional(const Graph& graph, int startActorId, int endActorId);
+
+    // Same query as a bidirectional A* search guided by landmark lower bounds (see landmarks.h)
+    // Finds an equally strong path while settling only the actors "on the way" to the target
+    // Falls back to findStrongestPath if the landmarks weren't built for this graph
+    static PathResult findStrongestPathAStar(
+        const Graph& graph,
+        const LandmarkIndex& landmarks,
+        int startActorId,
+        int endActorId
+    );
+
+    // Same query on a contraction hierarchy (see contractionHierarchy.h): both ends first climb
+    // the upward edges to the core, then a bidirectional search runs over the core alone, and
+    // the shortcuts on the best path are unpacked into real edges
+    // Falls back to findStrongestPath if the hierarchy wasn't built for this graph
+    static PathResult findStrongestPathCH(
+        const Graph& graph,
+        const ContractionHierarchy& hierarchy,
+        int startActorId,
+        int endActorId
+    );
+
+    // Strongest-path costs from one actor to every other actor (a full Dijkstra, no target)
+    static CostTable computeCostTable(const Graph& graph, int startActorId);
+
+    // Same table from a parallel delta-stepping search (Meyer & Sanders) on threadCount threads
+    // (0 uses every core). Reached actors wait in buckets of bucketWidth cost (0 uses
+    // DEFAULT_BUCKET_WIDTH) and the lowest bucket is emptied by all threads together.
+    // Light edges (cost up to bucketWidth) can put actors back into the bucket being emptied,
+    // so they are relaxed in rounds until it stays empty, and heavy edges only once afterwards
+    // from every actor the bucket settled. Costs are lowered with a compare-and-swap, and the
+    // parents are picked once every cost is final.
+    // Costs match computeCostTable, parents may differ where several paths are equally strong
+    static CostTable computeCostTableParallel(
+        const Graph& graph,
+        int startActorId,
+        double bucketWidth = 0.0,
+        unsigned int threadCount = 0
+    );
+
+    // Sum of the inverted edge costs along a path of actor IDs (what the search minimizes)
+    static double calculatePathCost(const Graph& graph, const std::vector<int>& path);
 
     // Helper method to print the path nicely
     static void printPath(const PathResult& result);
 
+    // Convert weight to cost (inverted)
+    // Higher weight (more collaborations) = lower cost
+    // (Public so the contraction hierarchy is built over exactly the same costs)
+    static double weightToCost(int weight, int maxWeight);
+
+    // Integer cost units per 1.0 of cost for the radix heap, fine enough that rounding
+    // only decides between paths whose costs tie to within about 1e-9
+    static constexpr double COST_UNIT_SCALE = 4294967296.0;
+
+    // Bucket width for computeCostTableParallel. Most edges cost 0.5 (a single shared movie),
+    // so with narrow buckets almost every edge is heavy and actors are rarely expanded twice.
+    // On the movie graph one thread ran 5-15% behind computeCostTable at this width and
+    // 30-50% behind at 0.25, while a bucket still held ~1.3k actors to share out.
+    static constexpr double DEFAULT_BUCKET_WIDTH = 0.025;
+
 private:
-    // Node structure for priority queue
-    struct Node {
-        int actorId;
-        double cost;  // Inverted weight (lower cost = stronger collaboration)
+    // Dijkstra's main loop over one queue type, reading and writing costs in the given array
+    // edgeCost turns an edge weight into the cost type the queue is keyed on
+    // Returns whether endIndex was settled (-1 settles everything reachable),
+    // with the parents in workspace.parent
+    template <typename Queue, typename Cost, typename EdgeCost>
+    static bool runSearch(
+        const Graph& graph,
+        QueryWorkspace& workspace,
+        Queue& queue,
+        std::vector<Cost>& cost,
+        EdgeCost edgeCost,
+        int startIndex,
+        int endIndex,
+        int& nodesExpanded
+    );
 
-        Node(int id, double c) : actorId(id), cost(c) {}
+    // Bidirectional Dijkstra from startIndex and endIndex on workspace slots 0 and 1
+    // Side 0 queues actors by cost + potential(index) and side 1 by cost - potential(index),
+    // (0 for plain bidirectional Dijkstra, the ALT average potential for A*)
+    // Returns whether the searches met, meetFrom -> meetTo being the edge on the best path
+    template <typename Potential>
+    static bool runBidirectional(
+        const Graph& graph,
+        int startIndex,
+        int endIndex,
+        Potential potential,
+        int& nodesExpanded,
+        int& meetFrom,
+        int& meetTo
+    );
 
-        // For priority queue (min-heap based on cost)
-        bool operator>(const Node& other) const {
-            return cost > other.cost;
-        }
-    };
+    // Join the two halves of a bidirectional search into one path of actor IDs
+    static std::vector<int> reconstructBidirectionalPath(
+        const Graph& graph,
+        int startIndex,
+        int meetFrom,
+        int meetTo,
+        int endIndex
+    );
 
-    // Reconstruct the path from parent map
+    // Reconstruct the path (as actor IDs) from the dense parent array
     static std::vector<int> reconstructPath(
-        const std::unordered_map<int, int>& parent,
-        int startActorId,
-        int endActorId
+        const Graph& graph,
+        const std::vector<int>& parent,
+        int startIndex,
+        int endIndex
     );
 
     // Calculate total weight of a path
     static int calculatePathWeight(const Graph& graph, const std::vector<int>& path);
 
-    // Convert weight to cost (inverted)
-    // Higher weight (more collaborations) = lower cost
-    static double weightToCost(int weight, int maxWeight);
+    // Same cost, rounded to integer units for the radix heap
+    static std::uint64_t weightToCostUnits(int weight, int maxWeight);
 };
 
 #endif // DIJKSTRA_H
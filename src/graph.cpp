@@ -1,15 +1,52 @@
 #include "graph.h"
+#include "checksum.h"
 #include <iostream>
 #include <algorithm>
-#include <cctype>
 #include <format>
+#include <fstream>
+#include <chrono>
+#include <cstring>
+#include <iterator>
+#include <atomic>
+#include <thread>
+#include <bit>
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+namespace {
+    // Runs work(thread, begin, end) over [0, count) in chunks of chunkSize, spread over the threads
+    template <typename Work>
+    void parallelChunks(size_t count, size_t chunkSize, unsigned int threadCount, Work work) {
+        std::atomic<size_t> nextChunk(0);
+        auto worker = [&](unsigned int t) {
+            for (size_t chunk = nextChunk.fetch_add(chunkSize); chunk < count; chunk = nextChunk.fetch_add(chunkSize)) {
+                work(t, chunk, std::min(chunk + chunkSize, count));
+            }
+        };
+
+        std::vector<std::thread> threads;
+        for (unsigned int t = 1; t < threadCount; t++) {
+            threads.emplace_back(worker, t);
+        }
+        worker(0);
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+    }
+
+    unsigned int defaultThreadCount() {
+        return std::max(1u, std::thread::hardware_concurrency());
+    }
+}
 
 //=====================================================================================
 //                          Constructor & Destructor
 //=====================================================================================
 
-Graph::Graph() : maxWeight(0) {
+Graph::Graph() : edgeCount(0), maxWeight(0), fingerprint(0), nameIndex(std::make_unique<LazyNameIndex>()) {
     // Initialize empty graph
+    fingerprint = computeFingerprint();
 }
 
 Graph::~Graph() {
@@ -20,47 +57,145 @@ Graph::~Graph() {
 //                          Graph Building Methods
 //=====================================================================================
 
-void Graph::loadFromDatabase(SQLite::Database& db) {
+void Graph::loadFromDatabase(SQLite::Database& db, unsigned int threadCount) {
     std::cout << "Loading graph from database...\n";
+    auto startTime = std::chrono::high_resolution_clock::now();
 
-    try {
-        // Step 1: Load all actors
-        SQLite::Statement actorQuery(db, "SELECT actor_id, actor_name FROM Actors;");
-        int actorCount = 0;
+    // Edge rows a thread reads at a time, each range is a rowid interval read on its own connection
+    constexpr std::int64_t ROWS_PER_RANGE = 262144;
 
-        while (actorQuery.executeStep()) {
-            int actorId = actorQuery.getColumn(0).getInt();
-            std::string actorName = actorQuery.getColumn(1).getString();
-            addActor(actorId, actorName);
-            actorCount++;
+    // Row blocks per thread for filling the adjacency, more than one so a block of hubs doesn't hold up the rest
+    constexpr size_t BLOCKS_PER_THREAD = 8;
 
-            if (actorCount % 10000 == 0) {
-                std::cout << std::format("Loaded {} actors...\n", actorCount);
+    if (threadCount == 0) {
+        threadCount = defaultThreadCount();
+    }
+
+    try {
+        clear();
+
+        // Step 1: Bulk load the actors, in ID order (actor_id is the rowid), straight into the packed arrays
+        size_t actorCount = static_cast<size_t>(db.execAndGet("SELECT COUNT(*) FROM Actors;").getInt64());
+        size_t nameBytes = static_cast<size_t>(
+            db.execAndGet("SELECT IFNULL(SUM(LENGTH(CAST(actor_name AS BLOB))), 0) FROM Actors;").getInt64());
+        owned.actorIds.reserve(actorCount);
+        owned.nameOffsets.reserve(actorCount + 1);
+        owned.names.reserve(nameBytes);
+        owned.nameOffsets.push_back(0);
+
+        SQLite::Statement actorQuery(db, "SELECT actor_id, actor_name FROM Actors ORDER BY actor_id;");
+        while (actorQuery.executeStep()) {
+            SQLite::Column name = actorQuery.getColumn(1);
+            const char* text = name.getText();
+            owned.actorIds.push_back(actorQuery.getColumn(0).getInt());
+            owned.names.insert(owned.names.end(), text, text + name.getBytes());
+            owned.nameOffsets.push_back(owned.names.size());
+        }
+        bindOwnedStorage();
+        std::cout << std::format("Loaded {} actors.\n", actorIds.size());
+
+        // Step 2: Read the edges in rowid ranges, one read-only connection per thread,
+        // translating them to dense indices on the way
+        // Both ends of every edge are bucketed by the block of rows they belong to, so later each
+        // block's rows are filled from its own buckets only, with no atomics and no thread scanning
+        // edges that aren't its own. There are several blocks per thread to keep them all busy.
+        struct LoadedEnd {
+            int row;
+            int target;
+            int weight;
+        };
+        size_t blockCount = std::min<size_t>(std::max<size_t>(actorIds.size(), 1), threadCount * BLOCKS_PER_THREAD);
+        size_t rowsPerBlock = (actorIds.size() + blockCount - 1) / blockCount;
+
+        std::int64_t firstRow = db.execAndGet("SELECT IFNULL(MIN(rowid), 0) FROM Actor_Edges;").getInt64();
+        std::int64_t lastRow = db.execAndGet("SELECT IFNULL(MAX(rowid), -1) FROM Actor_Edges;").getInt64();
+        size_t rangeCount = lastRow < firstRow ? 0 : static_cast<size_t>((lastRow - firstRow) / ROWS_PER_RANGE + 1);
+        std::vector<std::vector<std::vector<LoadedEnd>>> ranges(rangeCount); // [range][block]
+        std::vector<int> threadMaxWeight(threadCount, 0);
+        std::vector<size_t> threadEdges(threadCount, 0);
+        std::vector<size_t> threadSkipped(threadCount, 0);
+        std::string databasePath = db.getFilename();
+
+        // Connections can't be shared between threads, so each opens its own on first use
+        std::vector<std::unique_ptr<SQLite::Database>> connections(threadCount);
+        parallelChunks(rangeCount, 1, threadCount, [&](unsigned int t, size_t range, size_t) {
+            if (!connections[t]) {
+                connections[t] = std::make_unique<SQLite::Database>(databasePath, SQLite::OPEN_READONLY);
+            }
+            SQLite::Statement edgeQuery(*connections[t],
+                "SELECT actor1_id, actor2_id, weight FROM Actor_Edges WHERE rowid BETWEEN ? AND ?;");
+            std::int64_t rangeStart = firstRow + static_cast<std::int64_t>(range) * ROWS_PER_RANGE;
+            edgeQuery.bind(1, static_cast<std::int64_t>(rangeStart));
+            edgeQuery.bind(2, static_cast<std::int64_t>(std::min(rangeStart + ROWS_PER_RANGE - 1, lastRow)));
+
+            std::vector<std::vector<LoadedEnd>>& buckets = ranges[range];
+            buckets.resize(blockCount);
+            while (edgeQuery.executeStep()) {
+                int index1 = getIndex(edgeQuery.getColumn(0).getInt());
+                int index2 = getIndex(edgeQuery.getColumn(1).getInt());
+                int weight = edgeQuery.getColumn(2).getInt();
+                if (index1 == -1 || index2 == -1) {
+                    threadSkipped[t]++;
+                    continue;
+                }
+                buckets[index1 / rowsPerBlock].push_back(LoadedEnd{ index1, index2, weight });
+                if (index2 != index1) {
+                    buckets[index2 / rowsPerBlock].push_back(LoadedEnd{ index2, index1, weight });
+                }
+                threadEdges[t]++;
+                threadMaxWeight[t] = std::max(threadMaxWeight[t], weight);
             }
+        });
+        connections.clear();
+
+        size_t skipped = 0;
+        for (unsigned int t = 0; t < threadCount; t++) {
+            maxWeight = std::max(maxWeight, threadMaxWeight[t]);
+            edgeCount += threadEdges[t];
+            skipped += threadSkipped[t];
+        }
+        if (skipped > 0) {
+            std::cerr << std::format("Warning: Skipped {} edges between non-existent actors\n", skipped);
         }
 
-        std::cout << std::format("Loaded {} actors total.\n", actorCount);
-
-        // Step 2: Load all edges
-        SQLite::Statement edgeQuery(db,
-            "SELECT actor1_id, actor2_id, weight FROM Actor_Edges;");
-        int edgeCount = 0;
-
-        while (edgeQuery.executeStep()) {
-            int actor1Id = edgeQuery.getColumn(0).getInt();
-            int actor2Id = edgeQuery.getColumn(1).getInt();
-            int weight = edgeQuery.getColumn(2).getInt();
-
-            addEdge(actor1Id, actor2Id, weight);
-            edgeCount++;
-
-            if (edgeCount % 50000 == 0) {
-                std::cout << std::format("Loaded {} edges...\n", edgeCount);
+        // Step 3: First pass counts every actor's degree, which gives every row its place in the adjacency arrays
+        owned.offsets.assign(actorIds.size() + 1, 0);
+        parallelChunks(blockCount, 1, threadCount, [&](unsigned int, size_t block, size_t) {
+            for (const auto& buckets : ranges) {
+                for (const LoadedEnd& end : buckets[block]) {
+                    owned.offsets[end.row + 1]++;
+                }
             }
+        });
+        for (size_t i = 1; i < owned.offsets.size(); i++) {
+            owned.offsets[i] += owned.offsets[i - 1];
         }
 
-        std::cout << std::format("Loaded {} edges total.\n", edgeCount);
-        std::cout << "Graph loading complete!\n";
+        // Step 4: Second pass fills the preallocated arrays, freeing each bucket once it's placed
+        owned.targets.assign(owned.offsets.back(), -1);
+        owned.weights.assign(owned.offsets.back(), 0);
+        std::vector<std::uint64_t> cursor(owned.offsets.begin(), owned.offsets.end() - 1);
+        parallelChunks(blockCount, 1, threadCount, [&](unsigned int, size_t block, size_t) {
+            for (auto& buckets : ranges) {
+                for (const LoadedEnd& end : buckets[block]) {
+                    std::uint64_t slot = cursor[end.row]++;
+                    owned.targets[slot] = end.target;
+                    owned.weights[slot] = end.weight;
+                }
+                std::vector<LoadedEnd>().swap(buckets[block]);
+            }
+        });
+        ranges.clear();
+
+        // Step 5: Same finishing steps as finalize()
+        sortRows(threadCount);
+        bindOwnedStorage();
+        buildComponents();
+        fingerprint = computeFingerprint();
+
+        auto endTime = std::chrono::high_resolution_clock::now();
+        std::cout << std::format("Graph loaded from database in {:.1f} ms on {} threads\n",
+            std::chrono::duration<double, std::milli>(endTime - startTime).count(), threadCount);
         printStatistics();
     }
     catch (const std::exception& e) {
@@ -70,123 +205,736 @@ void Graph::loadFromDatabase(SQLite::Database& db) {
 }
 
 void Graph::addActor(int actorId, const std::string& actorName) {
-    if (actors.find(actorId) == actors.end()) {
-        actors[actorId] = Actor(actorId, actorName);
-        adjList[actorId] = std::vector<Edge>(); // Initialize empty neighbor list
-    }
+    // Duplicates are dropped in finalize(), the first one added wins
+    pendingActors.emplace_back(actorId, actorName);
 }
 
 void Graph::addEdge(int actor1Id, int actor2Id, int weight) {
-    // Ensure both actors exist
-    if (!hasActor(actor1Id) || !hasActor(actor2Id)) {
-        std::cerr << std::format("Warning: Attempting to add edge between non-existent actors ({}, {})\n",
-            actor1Id, actor2Id);
-        return;
+    // Actors are checked in finalize(), since they may be added after their edges
+    pendingEdges.push_back(PendingEdge{ actor1Id, actor2Id, weight });
+}
+
+void Graph::finalize() {
+    // Step 1: If the graph was already packed (or mapped), unpack it back to IDs first
+    // (each undirected edge is stored twice, so only keep one direction)
+    if (!actorIds.empty()) {
+        std::vector<std::pair<int, std::string>> allActors;
+        allActors.reserve(actorIds.size() + pendingActors.size());
+        for (size_t i = 0; i < actorIds.size(); i++) {
+            allActors.emplace_back(actorIds[i], std::string(getName(static_cast<int>(i))));
+        }
+        std::move(pendingActors.begin(), pendingActors.end(), std::back_inserter(allActors));
+        pendingActors.swap(allActors);
+
+        std::vector<PendingEdge> allEdges;
+        allEdges.reserve(edgeCount + pendingEdges.size());
+        for (size_t i = 0; i + 1 < offsets.size(); i++) {
+            for (size_t k = offsets[i]; k < offsets[i + 1]; k++) {
+                if (static_cast<size_t>(targets[k]) >= i) {
+                    allEdges.push_back(PendingEdge{ actorIds[i], actorIds[targets[k]], weights[k] });
+                }
+            }
+        }
+        allEdges.insert(allEdges.end(), pendingEdges.begin(), pendingEdges.end());
+        pendingEdges.swap(allEdges);
     }
+    snapshot.reset();
+
+    // Step 2: Sort actors by ID so that dense indices follow ID order, then pack the names
+    std::stable_sort(pendingActors.begin(), pendingActors.end(),
+        [](const auto& a, const auto& b) { return a.first < b.first; });
+    pendingActors.erase(std::unique(pendingActors.begin(), pendingActors.end(),
+        [](const auto& a, const auto& b) { return a.first == b.first; }), pendingActors.end());
+
+    owned = OwnedStorage();
+    owned.actorIds.reserve(pendingActors.size());
+    owned.nameOffsets.reserve(pendingActors.size() + 1);
+    owned.nameOffsets.push_back(0);
+    for (const auto& [actorId, actorName] : pendingActors) {
+        owned.actorIds.push_back(actorId);
+        owned.names.insert(owned.names.end(), actorName.begin(), actorName.end());
+        owned.nameOffsets.push_back(owned.names.size());
+    }
+    pendingActors.clear();
+    pendingActors.shrink_to_fit();
+    bindOwnedStorage();
+    idLookup.clear(); // Back in ID order, so IDs are searched in actorIds directly
+
+    // Step 3: Translate edges to dense indices and count the degree of every actor
+    owned.offsets.assign(actorIds.size() + 1, 0);
+    edgeCount = 0;
+    maxWeight = 0;
 
-    // Add bidirectional edge (undirected graph)
-    adjList[actor1Id].push_back(Edge(actor2Id, weight));
-    adjList[actor2Id].push_back(Edge(actor1Id, weight));
+    for (PendingEdge& edge : pendingEdges) {
+        int index1 = getIndex(edge.actor1Id);
+        int index2 = getIndex(edge.actor2Id);
+        if (index1 == -1 || index2 == -1) {
+            std::cerr << std::format("Warning: Attempting to add edge between non-existent actors ({}, {})\n",
+                edge.actor1Id, edge.actor2Id);
+            edge.actor1Id = -1;
+            continue;
+        }
 
-    // Track maximum weight
-    if (weight > maxWeight) {
-        maxWeight = weight;
+        edge.actor1Id = index1;
+        edge.actor2Id = index2;
+        owned.offsets[index1 + 1]++;
+        if (index1 != index2) {
+            owned.offsets[index2 + 1]++;
+        }
+    }
+
+    for (size_t i = 1; i < owned.offsets.size(); i++) {
+        owned.offsets[i] += owned.offsets[i - 1];
     }
+
+    // Step 4: Scatter the bidirectional edges into their rows (undirected graph)
+    owned.targets.assign(owned.offsets.back(), -1);
+    owned.weights.assign(owned.offsets.back(), 0);
+    std::vector<std::uint64_t> cursor(owned.offsets.begin(), owned.offsets.end() - 1);
+
+    for (const PendingEdge& edge : pendingEdges) {
+        if (edge.actor1Id == -1) {
+            continue;
+        }
+
+        std::uint64_t slot = cursor[edge.actor1Id]++;
+        owned.targets[slot] = edge.actor2Id;
+        owned.weights[slot] = edge.weight;
+
+        if (edge.actor1Id != edge.actor2Id) {
+            slot = cursor[edge.actor2Id]++;
+            owned.targets[slot] = edge.actor1Id;
+            owned.weights[slot] = edge.weight;
+        }
+
+        edgeCount++;
+
+        // Track maximum weight
+        if (edge.weight > maxWeight) {
+            maxWeight = edge.weight;
+        }
+    }
+
+    // The staging list is no longer needed
+    pendingEdges.clear();
+    pendingEdges.shrink_to_fit();
+
+    // Step 5: Sort every row by target, so edge lookups can binary search it
+    sortRows(defaultThreadCount());
+    bindOwnedStorage();
+
+    // Indices changed, so the name index has to be rebuilt on next use
+    nameIndex = std::make_unique<LazyNameIndex>();
+    buildComponents();
+    fingerprint = computeFingerprint();
+}
+
+void Graph::sortRows(unsigned int threadCount) {
+    // Rows go to the threads in chunks of actors, each thread sorting in its own scratch row
+    std::vector<std::vector<std::pair<int, int>>> scratch(threadCount);
+    parallelChunks(owned.offsets.size() - 1, 1024, threadCount, [&](unsigned int t, size_t begin, size_t end) {
+        std::vector<std::pair<int, int>>& row = scratch[t];
+        for (size_t i = begin; i < end; i++) {
+            row.clear();
+            for (std::uint64_t k = owned.offsets[i]; k < owned.offsets[i + 1]; k++) {
+                row.emplace_back(owned.targets[k], owned.weights[k]);
+            }
+            std::sort(row.begin(), row.end());
+            for (size_t k = 0; k < row.size(); k++) {
+                owned.targets[owned.offsets[i] + k] = row[k].first;
+                owned.weights[owned.offsets[i] + k] = row[k].second;
+            }
+        }
+    });
+}
+
+void Graph::bindOwnedStorage() {
+    actorIds = owned.actorIds;
+    nameOffsets = owned.nameOffsets;
+    names = owned.names;
+    offsets = owned.offsets;
+    targets = owned.targets;
+    weights = owned.weights;
 }
 
 //=====================================================================================
-//                          Query Methods
+//                          Connected Components
 //=====================================================================================
 
-bool Graph::hasActor(int actorId) const {
-    return actors.find(actorId) != actors.end();
+void Graph::buildComponents() {
+    const size_t actorCount = actorIds.size();
+    const int count = static_cast<int>(actorCount);
+
+    // Union-find where every link points a root at a lower index root, so no cycles can
+    // form and threads can link with a compare-and-swap instead of a lock
+    std::vector<int> parent(actorCount);
+    for (int index = 0; index < count; index++) {
+        parent[index] = index;
+    }
+
+    // Root of index, halving the path on the way (any thread's shortcut is still a valid path)
+    auto find = [&](int index) {
+        while (true) {
+            std::atomic_ref<int> link(parent[index]);
+            int up = link.load(std::memory_order_relaxed);
+            if (up == index) {
+                return index;
+            }
+            int upUp = std::atomic_ref<int>(parent[up]).load(std::memory_order_relaxed);
+            if (upUp != up) {
+                link.compare_exchange_weak(up, upUp, std::memory_order_relaxed);
+            }
+            index = upUp;
+        }
+    };
+
+    auto unite = [&](int a, int b) {
+        while (true) {
+            a = find(a);
+            b = find(b);
+            if (a == b) {
+                return;
+            }
+            if (a < b) {
+                std::swap(a, b);
+            }
+            // Fails if another thread linked a meanwhile, then retry from the new roots
+            int expected = a;
+            if (std::atomic_ref<int>(parent[a]).compare_exchange_strong(expected, b, std::memory_order_relaxed)) {
+                return;
+            }
+        }
+    };
+
+    // Each edge is stored in both directions, so only the one to the lower index is needed
+    parallelChunks(actorCount, 1024, defaultThreadCount(), [&](unsigned int, size_t begin, size_t end) {
+        for (int index = static_cast<int>(begin); index < static_cast<int>(end); index++) {
+            for (int neighborIndex : getNeighborIndices(index)) {
+                if (neighborIndex < index) {
+                    unite(index, neighborIndex);
+                }
+            }
+        }
+    });
+
+    // Number the components by size, largest first (ties by lowest index)
+    std::vector<size_t> rootSize(actorCount, 0);
+    for (int index = 0; index < count; index++) {
+        parent[index] = find(index);
+        rootSize[parent[index]]++;
+    }
+    std::vector<int> roots;
+    for (int index = 0; index < count; index++) {
+        if (parent[index] == index) {
+            roots.push_back(index);
+        }
+    }
+    std::stable_sort(roots.begin(), roots.end(), [&](int a, int b) { return rootSize[a] > rootSize[b]; });
+
+    std::vector<int> rootComponent(actorCount, -1);
+    componentSizes.clear();
+    for (int root : roots) {
+        rootComponent[root] = static_cast<int>(componentSizes.size());
+        componentSizes.push_back(rootSize[root]);
+    }
+    componentIds.resize(actorCount);
+    for (int index = 0; index < count; index++) {
+        componentIds[index] = rootComponent[parent[index]];
+    }
+}
+
+//=====================================================================================
+//                          Index Reordering
+//=====================================================================================
+
+void Graph::reorder(IndexOrder order) {
+    auto startTime = std::chrono::high_resolution_clock::now();
+    const int count = static_cast<int>(actorIds.size());
+
+    // Step 1: Pick the new order, as the old index that goes at each new index
+    std::vector<int> oldIndex(count);
+    for (int index = 0; index < count; index++) {
+        oldIndex[index] = index;
+    }
+
+    switch (order) {
+    case IndexOrder::ActorId:
+        std::sort(oldIndex.begin(), oldIndex.end(), [&](int a, int b) { return actorIds[a] < actorIds[b]; });
+        break;
+    case IndexOrder::Degree:
+        std::stable_sort(oldIndex.begin(), oldIndex.end(), [&](int a, int b) { return getDegree(a) > getDegree(b); });
+        break;
+    case IndexOrder::CuthillMcKee:
+        oldIndex = cuthillMcKeeOrder();
+        break;
+    }
+
+    std::vector<int> newIndex(count);
+    for (int index = 0; index < count; index++) {
+        newIndex[oldIndex[index]] = index;
+    }
+
+    // Step 2: Copy every array over in the new order (the spans still point at the old ones)
+    OwnedStorage storage;
+    storage.actorIds.resize(count);
+    storage.nameOffsets.reserve(count + 1);
+    storage.nameOffsets.push_back(0);
+    storage.names.reserve(names.size());
+    storage.offsets.resize(count + 1, 0);
+    for (int index = 0; index < count; index++) {
+        int old = oldIndex[index];
+        std::string_view name = getName(old);
+        storage.actorIds[index] = actorIds[old];
+        storage.names.insert(storage.names.end(), name.begin(), name.end());
+        storage.nameOffsets.push_back(storage.names.size());
+        storage.offsets[index + 1] = storage.offsets[index] + getDegree(old);
+    }
+
+    storage.targets.resize(targets.size());
+    storage.weights.resize(weights.size());
+    parallelChunks(count, 1024, defaultThreadCount(), [&](unsigned int, size_t begin, size_t end) {
+        for (size_t index = begin; index < end; index++) {
+            std::uint64_t slot = storage.offsets[index];
+            std::uint64_t from = offsets[oldIndex[index]];
+            std::uint64_t to = offsets[oldIndex[index] + 1];
+            for (std::uint64_t k = from; k < to; k++, slot++) {
+                storage.targets[slot] = newIndex[targets[k]];
+                storage.weights[slot] = weights[k];
+            }
+        }
+    });
+
+    // Step 3: Switch over to the new arrays, the renumbered rows need sorting by target again
+    owned = std::move(storage);
+    snapshot.reset();
+    sortRows(defaultThreadCount());
+    bindOwnedStorage();
+    buildIdLookup();
+
+    // Indices changed, so the name index has to be rebuilt on next use
+    nameIndex = std::make_unique<LazyNameIndex>();
+    buildComponents();
+    fingerprint = computeFingerprint();
+
+    auto endTime = std::chrono::high_resolution_clock::now();
+    std::cout << std::format("Graph reordered in {:.1f} ms\n",
+        std::chrono::duration<double, std::milli>(endTime - startTime).count());
+}
+
+std::vector<int> Graph::cuthillMcKeeOrder() const {
+    const int count = static_cast<int>(actorIds.size());
+    auto byDegree = [&](int a, int b) { return getDegree(a) < getDegree(b); };
+
+    // Each component is walked breadth-first from its lowest degree actor (a cheap stand-in for
+    // a peripheral one), with the neighbors of every actor queued lowest degree first
+    std::vector<int> starts(count);
+    for (int index = 0; index < count; index++) {
+        starts[index] = index;
+    }
+    std::stable_sort(starts.begin(), starts.end(), byDegree);
+
+    std::vector<int> order;
+    order.reserve(count);
+    std::vector<char> placed(count, 0);
+    for (int start : starts) {
+        if (placed[start]) {
+            continue;
+        }
+        placed[start] = 1;
+        order.push_back(start);
+
+        for (size_t head = order.size() - 1; head < order.size(); head++) {
+            size_t firstNew = order.size();
+            for (int neighborIndex : getNeighborIndices(order[head])) {
+                if (!placed[neighborIndex]) {
+                    placed[neighborIndex] = 1;
+                    order.push_back(neighborIndex);
+                }
+            }
+            std::stable_sort(order.begin() + firstNew, order.end(), byDegree);
+        }
+    }
+
+    // Reversing puts the hubs each level leads to ahead of the low degree actors that reach them
+    std::reverse(order.begin(), order.end());
+    return order;
 }
 
-const Actor* Graph::getActor(int actorId) const {
-    auto it = actors.find(actorId);
-    if (it != actors.end()) {
-        return &(it->second);
+void Graph::buildIdLookup() {
+    idLookup.clear();
+    if (std::is_sorted(actorIds.begin(), actorIds.end())) {
+        return;
     }
-    return nullptr;
+
+    idLookup.reserve(actorIds.size());
+    for (size_t index = 0; index < actorIds.size(); index++) {
+        idLookup.emplace_back(actorIds[index], static_cast<int>(index));
+    }
+    std::sort(idLookup.begin(), idLookup.end());
 }
 
-const Actor* Graph::getActorByName(const std::string& name) const {
-    // Convert search name to lowercase for case-insensitive comparison
-    std::string lowerName = name;
-    std::transform(lowerName.begin(), lowerName.end(), lowerName.begin(), ::tolower);
+//=====================================================================================
+//                          Snapshot Methods
+//=====================================================================================
+// File layout: a fixed header, then each array as its own section, 8 byte aligned
+// so the mapped memory can be read in place. Bump SNAPSHOT_VERSION on any layout change.
+// Version 2: every row of the adjacency is sorted by target
+// Version 3: actor IDs can be in any order (a reordered graph), the ID lookup is rebuilt on load
+// Version 4: the header carries the graph fingerprint, so loading doesn't hash the arrays twice
+
+namespace {
+    constexpr char SNAPSHOT_MAGIC[8] = { 'A', 'C', 'T', 'G', 'R', 'A', 'P', 'H' };
+    constexpr std::uint32_t SNAPSHOT_VERSION = 4;
+
+    enum SnapshotSection {
+        SECTION_ACTOR_IDS,
+        SECTION_NAME_OFFSETS,
+        SECTION_NAMES,
+        SECTION_OFFSETS,
+        SECTION_TARGETS,
+        SECTION_WEIGHTS,
+        SECTION_COUNT
+    };
+
+    struct SnapshotHeader {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t headerSize;      // Catches layout changes that forgot the version bump
+        std::uint64_t actorCount;
+        std::uint64_t adjacencyCount;  // Directed entries in targets/weights
+        std::uint64_t edgeCount;
+        std::int32_t maxWeight;
+        std::uint32_t reserved;
+        std::uint64_t sectionOffset[SECTION_COUNT]; // Bytes from the start of the file
+        std::uint64_t sectionSize[SECTION_COUNT];   // Bytes, without padding
+        std::uint64_t payloadChecksum;              // Over everything after the header
+        std::uint64_t graphFingerprint;             // Graph::getFingerprint()
+    };
+    static_assert(sizeof(SnapshotHeader) % 8 == 0, "Snapshot sections must stay 8 byte aligned");
+}
+
+bool Graph::saveSnapshot(const std::string& path) const {
+    auto startTime = std::chrono::high_resolution_clock::now();
+
+    const void* sectionData[SECTION_COUNT] = {
+        actorIds.data(), nameOffsets.data(), names.data(), offsets.data(), targets.data(), weights.data()
+    };
+
+    SnapshotHeader header{};
+    header.actorCount = actorIds.size();
+    header.adjacencyCount = targets.size();
+    header.edgeCount = edgeCount;
+    header.maxWeight = maxWeight;
+    header.graphFingerprint = fingerprint;
+    header.sectionSize[SECTION_ACTOR_IDS] = actorIds.size_bytes();
+    header.sectionSize[SECTION_NAME_OFFSETS] = nameOffsets.size_bytes();
+    header.sectionSize[SECTION_NAMES] = names.size_bytes();
+    header.sectionSize[SECTION_OFFSETS] = offsets.size_bytes();
+    header.sectionSize[SECTION_TARGETS] = targets.size_bytes();
+    header.sectionSize[SECTION_WEIGHTS] = weights.size_bytes();
+
+    std::uint64_t position = sizeof(SnapshotHeader);
+    for (int section = 0; section < SECTION_COUNT; section++) {
+        header.sectionOffset[section] = position;
+        position += sectionSize(header.sectionSize[section]);
+    }
 
-    for (const auto& pair : actors) {
-        std::string actorNameLower = pair.second.name;
-        std::transform(actorNameLower.begin(), actorNameLower.end(),
-            actorNameLower.begin(), ::tolower);
+    bool saved = writeFramedFile(path, "graph snapshot", SNAPSHOT_MAGIC, SNAPSHOT_VERSION, header,
+        [&](std::ofstream& file, std::uint64_t& checksum) {
+            for (int section = 0; section < SECTION_COUNT; section++) {
+                writeSection(file, checksum, sectionData[section], header.sectionSize[section]);
+            }
+        });
+    if (!saved) {
+        return false;
+    }
 
-        if (actorNameLower == lowerName) {
-            return &(pair.second);
+    auto endTime = std::chrono::high_resolution_clock::now();
+    std::cout << std::format("Graph snapshot saved to {} ({} MB) in {:.1f} ms\n", path, position / (1024 * 1024),
+        std::chrono::duration<double, std::milli>(endTime - startTime).count());
+    return true;
+}
+
+bool Graph::loadSnapshot(const std::string& path, bool verifyChecksum) {
+    auto startTime = std::chrono::high_resolution_clock::now();
+    clear();
+
+    auto file = std::make_unique<MappedFile>();
+    if (!file->open(path)) {
+        return false;
+    }
+
+    SnapshotHeader header;
+    if (!readFileHeader(file->data(), file->size(), path, "Graph snapshot", SNAPSHOT_MAGIC, SNAPSHOT_VERSION, header)) {
+        return false;
+    }
+
+    const std::uint64_t expectedSize[SECTION_COUNT] = {
+        header.actorCount * sizeof(int),
+        (header.actorCount + 1) * sizeof(std::uint64_t),
+        header.sectionSize[SECTION_NAMES],
+        (header.actorCount + 1) * sizeof(std::uint64_t),
+        header.adjacencyCount * sizeof(int),
+        header.adjacencyCount * sizeof(int)
+    };
+    for (int section = 0; section < SECTION_COUNT; section++) {
+        std::uint64_t offset = header.sectionOffset[section];
+        std::uint64_t size = header.sectionSize[section];
+        if (size != expectedSize[section] || offset % 8 != 0 || offset > file->size() || size > file->size() - offset) {
+            std::cerr << std::format("Warning: Graph snapshot {} has a corrupt layout, ignoring it.\n", path);
+            return false;
+        }
+    }
+
+    if (verifyChecksum) {
+        std::uint64_t checksum = CHECKSUM_SEED;
+        updateChecksum(checksum, file->data() + sizeof(SnapshotHeader), file->size() - sizeof(SnapshotHeader));
+        if (checksum != header.payloadChecksum) {
+            std::cerr << std::format("Warning: Graph snapshot {} failed its checksum, ignoring it.\n", path);
+            return false;
         }
     }
 
-    return nullptr;
+    // Point every span straight into the mapping, nothing is copied
+    auto section = [&](int index) { return file->data() + header.sectionOffset[index]; };
+    actorIds = std::span<const int>(reinterpret_cast<const int*>(section(SECTION_ACTOR_IDS)), header.actorCount);
+    nameOffsets = std::span<const std::uint64_t>(
+        reinterpret_cast<const std::uint64_t*>(section(SECTION_NAME_OFFSETS)), header.actorCount + 1);
+    names = std::span<const char>(reinterpret_cast<const char*>(section(SECTION_NAMES)), header.sectionSize[SECTION_NAMES]);
+    offsets = std::span<const std::uint64_t>(
+        reinterpret_cast<const std::uint64_t*>(section(SECTION_OFFSETS)), header.actorCount + 1);
+    targets = std::span<const int>(reinterpret_cast<const int*>(section(SECTION_TARGETS)), header.adjacencyCount);
+    weights = std::span<const int>(reinterpret_cast<const int*>(section(SECTION_WEIGHTS)), header.adjacencyCount);
+
+    if (offsets.back() != header.adjacencyCount || nameOffsets.back() != names.size()) {
+        std::cerr << std::format("Warning: Graph snapshot {} has inconsistent arrays, ignoring it.\n", path);
+        clear();
+        return false;
+    }
+
+    edgeCount = header.edgeCount;
+    maxWeight = header.maxWeight;
+    fingerprint = header.graphFingerprint;
+    snapshot = std::move(file);
+    buildIdLookup();
+    buildComponents();
+
+    auto endTime = std::chrono::high_resolution_clock::now();
+    std::cout << std::format("Graph snapshot {} mapped in {:.1f} ms\n", path,
+        std::chrono::duration<double, std::milli>(endTime - startTime).count());
+    printStatistics();
+    return true;
 }
 
-std::vector<Actor> Graph::searchActorsByName(const std::string& partialName) const {
-    std::vector<Actor> results;
+bool Graph::isSnapshot() const {
+    return snapshot != nullptr;
+}
 
-    // Convert search term to lowercase
-    std::string lowerPartial = partialName;
-    std::transform(lowerPartial.begin(), lowerPartial.end(),
-        lowerPartial.begin(), ::tolower);
+std::uint64_t Graph::getFingerprint() const {
+    return fingerprint;
+}
 
-    for (const auto& pair : actors) {
-        std::string actorNameLower = pair.second.name;
-        std::transform(actorNameLower.begin(), actorNameLower.end(),
-            actorNameLower.begin(), ::tolower);
+std::uint64_t Graph::computeFingerprint() const {
+    std::uint64_t hash = CHECKSUM_SEED;
+    updateChecksum(hash, actorIds.data(), actorIds.size_bytes());
+    updateChecksum(hash, offsets.data(), offsets.size_bytes());
+    updateChecksum(hash, targets.data(), targets.size_bytes());
+    updateChecksum(hash, weights.data(), weights.size_bytes());
+    return hash;
+}
 
-        // Check if the partial name is contained in the actor's name
-        if (actorNameLower.find(lowerPartial) != std::string::npos) {
-            results.push_back(pair.second);
+//=====================================================================================
+//                          Query Methods
+//=====================================================================================
+
+namespace {
+    // Rows up to this long are scanned whole instead of binary searched
+    // (a handful of compares 4 targets wide beats the unpredictable branches of a binary search)
+    constexpr size_t LINEAR_SCAN_LIMIT = 32;
+
+    // Position of target in a row sorted by target, or -1
+    std::ptrdiff_t findInRow(std::span<const int> row, int target) {
+        if (row.size() > LINEAR_SCAN_LIMIT) {
+            auto found = std::lower_bound(row.begin(), row.end(), target);
+            return (found != row.end() && *found == target) ? found - row.begin() : -1;
+        }
+
+        size_t i = 0;
+#if defined(__SSE2__) || defined(_M_X64)
+        __m128i key = _mm_set1_epi32(target);
+        for (; i + 4 <= row.size(); i += 4) {
+            __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row.data() + i));
+            int mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(block, key)));
+            if (mask != 0) {
+                return static_cast<std::ptrdiff_t>(i) + std::countr_zero(static_cast<unsigned int>(mask));
+            }
         }
+#endif
+        for (; i < row.size(); i++) {
+            if (row[i] == target) {
+                return static_cast<std::ptrdiff_t>(i);
+            }
+        }
+        return -1;
+    }
+}
+
+bool Graph::hasActor(int actorId) const {
+    return getIndex(actorId) != -1;
+}
+
+std::optional<Actor> Graph::getActor(int actorId) const {
+    int index = getIndex(actorId);
+    if (index != -1) {
+        return getActorByIndex(index);
+    }
+    return std::nullopt;
+}
+
+std::optional<Actor> Graph::getActorByName(const std::string& name) const {
+    int index = getNameIndex().findExact(name);
+    if (index != -1) {
+        return getActorByIndex(index);
     }
+    return std::nullopt;
+}
 
+std::vector<Actor> Graph::searchActorsByName(const std::string& partialName, size_t maxResults) const {
+    std::vector<Actor> results;
+    for (int index : getNameIndex().findSubstring(partialName, maxResults)) {
+        results.push_back(getActorByIndex(index));
+    }
     return results;
 }
 
-const std::vector<Edge>* Graph::getNeighbors(int actorId) const {
-    auto it = adjList.find(actorId);
-    if (it != adjList.end()) {
-        return &(it->second);
+const NameIndex& Graph::getNameIndex() const {
+    std::call_once(nameIndex->built, [this]() {
+        nameIndex->index = std::make_unique<NameIndex>(*this);
+    });
+    return *nameIndex->index;
+}
+
+std::vector<Edge> Graph::getNeighbors(int actorId) const {
+    std::vector<Edge> neighbors;
+    int index = getIndex(actorId);
+    if (index == -1) {
+        return neighbors;
     }
-    return nullptr;
+
+    std::span<const int> neighborIndices = getNeighborIndices(index);
+    std::span<const int> neighborWeights = getNeighborWeights(index);
+    neighbors.reserve(neighborIndices.size());
+    for (size_t i = 0; i < neighborIndices.size(); i++) {
+        neighbors.push_back(Edge(actorIds[neighborIndices[i]], neighborWeights[i]));
+    }
+
+    return neighbors;
 }
 
 int Graph::getEdgeWeight(int actor1Id, int actor2Id) const {
-    const std::vector<Edge>* neighbors = getNeighbors(actor1Id);
-    if (neighbors == nullptr) {
+    int index1 = getIndex(actor1Id);
+    int index2 = getIndex(actor2Id);
+    if (index1 == -1 || index2 == -1) {
         return 0;
     }
+    return getEdgeWeightByIndex(index1, index2);
+}
+
+size_t Graph::getActorCount() const {
+    return actorIds.size();
+}
+
+size_t Graph::getEdgeCount() const {
+    return edgeCount;
+}
 
-    for (const Edge& edge : *neighbors) {
-        if (edge.targetActorId == actor2Id) {
-            return edge.weight;
+int Graph::getMaxWeight() const {
+    return maxWeight;
+}
+
+//=====================================================================================
+//                          Dense Index Methods
+//=====================================================================================
+
+int Graph::getIndex(int actorId) const {
+    if (!idLookup.empty()) {
+        auto it = std::lower_bound(idLookup.begin(), idLookup.end(), actorId,
+            [](const std::pair<int, int>& entry, int id) { return entry.first < id; });
+        if (it != idLookup.end() && it->first == actorId) {
+            return it->second;
         }
+        return -1;
     }
 
-    return 0;
+    // Actors are sorted by ID, so a binary search is enough to translate
+    auto it = std::lower_bound(actorIds.begin(), actorIds.end(), actorId);
+    if (it != actorIds.end() && *it == actorId) {
+        return static_cast<int>(it - actorIds.begin());
+    }
+    return -1;
 }
 
-size_t Graph::getActorCount() const {
-    return actors.size();
+int Graph::getActorId(int index) const {
+    return actorIds[index];
 }
 
-size_t Graph::getEdgeCount() const {
-    size_t count = 0;
-    for (const auto& pair : adjList) {
-        count += pair.second.size();
+Actor Graph::getActorByIndex(int index) const {
+    return Actor(actorIds[index], getName(index));
+}
+
+std::string_view Graph::getName(int index) const {
+    return std::string_view(names.data() + nameOffsets[index], nameOffsets[index + 1] - nameOffsets[index]);
+}
+
+std::span<const int> Graph::getNeighborIndices(int index) const {
+    return std::span<const int>(targets.data() + offsets[index], offsets[index + 1] - offsets[index]);
+}
+
+std::span<const int> Graph::getNeighborWeights(int index) const {
+    return std::span<const int>(weights.data() + offsets[index], offsets[index + 1] - offsets[index]);
+}
+
+size_t Graph::getDegree(int index) const {
+    return offsets[index + 1] - offsets[index];
+}
+
+size_t Graph::getAdjacencySize() const {
+    return targets.size();
+}
+
+int Graph::getEdgeWeightByIndex(int index1, int index2) const {
+    // The edge is stored in both rows, so search the shorter one
+    if (getDegree(index1) > getDegree(index2)) {
+        std::swap(index1, index2);
     }
-    return count / 2; // Divide by 2 because edges are bidirectional
+    std::ptrdiff_t position = findInRow(getNeighborIndices(index1), index2);
+    return position == -1 ? 0 : getNeighborWeights(index1)[position];
 }
 
-int Graph::getMaxWeight() const {
-    return maxWeight;
+std::vector<int> Graph::getEdgeWeights(std::span<const std::pair<int, int>> indexPairs) const {
+    std::vector<int> result(indexPairs.size(), 0);
+    for (size_t i = 0; i < indexPairs.size(); i++) {
+        if (indexPairs[i].first != -1 && indexPairs[i].second != -1) {
+            result[i] = getEdgeWeightByIndex(indexPairs[i].first, indexPairs[i].second);
+        }
+    }
+    return result;
+}
+
+int Graph::getComponent(int index) const {
+    return componentIds[index];
+}
+
+bool Graph::areConnected(int index1, int index2) const {
+    return componentIds[index1] == componentIds[index2];
+}
+
+size_t Graph::getComponentCount() const {
+    return componentSizes.size();
+}
+
+size_t Graph::getComponentSize(int component) const {
+    return componentSizes[component];
 }
 
 //=====================================================================================
@@ -200,16 +948,38 @@ void Graph::printStatistics() const {
     std::cout << std::format("Maximum Edge Weight: {}\n", maxWeight);
 
     // Calculate average degree
-    if (!actors.empty()) {
-        double avgDegree = (2.0 * getEdgeCount()) / actors.size();
+    if (!actorIds.empty()) {
+        double avgDegree = (2.0 * getEdgeCount()) / actorIds.size();
         std::cout << std::format("Average Degree: {:.2f}\n", avgDegree);
     }
 
+    if (!componentSizes.empty()) {
+        size_t isolated = std::count(componentSizes.begin(), componentSizes.end(), 1);
+        std::cout << std::format("Connected Components: {}\n", componentSizes.size());
+        std::cout << std::format("Largest Component: {} actors ({:.1f}%)\n", componentSizes[0],
+            100.0 * componentSizes[0] / actorIds.size());
+        std::cout << std::format("Isolated Actors: {}\n", isolated);
+    }
+
     std::cout << "========================\n\n";
 }
 
 void Graph::clear() {
-    actors.clear();
-    adjList.clear();
+    actorIds = {};
+    nameOffsets = {};
+    names = {};
+    offsets = {};
+    targets = {};
+    weights = {};
+    owned = OwnedStorage();
+    snapshot.reset();
+    idLookup.clear();
+    nameIndex = std::make_unique<LazyNameIndex>();
+    pendingActors.clear();
+    pendingEdges.clear();
+    componentIds.clear();
+    componentSizes.clear();
+    edgeCount = 0;
     maxWeight = 0;
+    fingerprint = computeFingerprint();
 }
@@ -2,9 +2,17 @@
 #define GRAPH_H
 
 #include <string>
+#include <string_view>
 #include <vector>
-#include <unordered_map>
+#include <span>
+#include <optional>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
 #include <SQLiteCpp/SQLiteCpp.h>
+#include "mappedFile.h"
+#include "nameIndex.h"
 
 // Forward declarations
 struct Actor;
@@ -15,12 +23,14 @@ class Graph;
 //                              Actor Structure
 //=====================================================================================
 // Represents an actor node in the graph
+// The name points into the graph's packed name storage, so it is only valid
+// for as long as the graph it came from (copy it into a std::string to keep it)
 struct Actor {
     int id;
-    std::string name;
+    std::string_view name;
 
-    Actor() : id(-1), name("") {}
-    Actor(int actorId, const std::string& actorName)
+    Actor() : id(-1), name() {}
+    Actor(int actorId, std::string_view actorName)
         : id(actorId), name(actorName) {
     }
 };
@@ -30,6 +40,7 @@ struct Actor {
 //=====================================================================================
 // Represents a weighted edge between two actors
 // Weight = number of movies they've worked together on
+// (Only used at the API boundary, the graph itself stores edges in CSR arrays)
 struct Edge {
     int targetActorId;
     int weight; // Number of collaborations
@@ -41,18 +52,98 @@ struct Edge {
 //=====================================================================================
 //                              Graph Class
 //=====================================================================================
-// Adjacency list representation of the actor collaboration network
+// Compressed sparse row (CSR) representation of the actor collaboration network
+// TMDB actor IDs are remapped to dense indices 0..N-1 (in ascending ID order, unless the graph
+// was renumbered with reorder()), and the neighbors of index i live in
+// targets/weights[offsets[i] .. offsets[i + 1]), sorted by target.
+// Searches should work on indices, and translate back to IDs only for results.
+//
+// The arrays are read through spans, which either point at vectors owned by the graph
+// (after finalize()) or straight into a memory mapped snapshot file (after loadSnapshot()).
 class Graph {
 private:
-    // Map: actor_id -> Actor data
-    std::unordered_map<int, Actor> actors;
+    // Arrays owned by the graph when it was built in memory
+    struct OwnedStorage {
+        std::vector<int> actorIds;
+        std::vector<std::uint64_t> nameOffsets;
+        std::vector<char> names;
+        std::vector<std::uint64_t> offsets;
+        std::vector<int> targets;
+        std::vector<int> weights;
+    };
+    OwnedStorage owned;
 
-    // Map: actor_id -> list of edges (neighbors)
-    std::unordered_map<int, std::vector<Edge>> adjList;
+    // Snapshot file the spans point into, when loaded with loadSnapshot()
+    std::unique_ptr<MappedFile> snapshot;
+
+    // Dense index -> actor ID, sorted ascending unless the graph was reordered
+    std::span<const int> actorIds;
+
+    // (Actor ID, dense index) pairs sorted by ID, to translate IDs once the indices no longer
+    // follow ID order (empty while they do, then actorIds itself is binary searched)
+    std::vector<std::pair<int, int>> idLookup;
+
+    // Packed names, the name of index i is names[nameOffsets[i] .. nameOffsets[i + 1])
+    std::span<const std::uint64_t> nameOffsets;
+    std::span<const char> names;
+
+    // CSR adjacency, offsets has one entry per actor plus a sentinel
+    std::span<const std::uint64_t> offsets;
+    std::span<const int> targets; // Dense index of the neighbor
+    std::span<const int> weights; // Collaboration count, parallel to targets
+
+    // Actors and edges added since the last finalize(), stored as actor IDs
+    struct PendingEdge {
+        int actor1Id;
+        int actor2Id;
+        int weight;
+    };
+    std::vector<std::pair<int, std::string>> pendingActors;
+    std::vector<PendingEdge> pendingEdges;
+
+    // Number of undirected edges in the CSR arrays
+    size_t edgeCount;
 
     // Track max weight for potential normalization
     int maxWeight;
 
+    // getFingerprint(), computed whenever the arrays are rebuilt since indexes check it on every query
+    std::uint64_t fingerprint;
+
+    // Trigram/exact name index, built on the first name lookup so startup stays fast
+    // (Kept behind a pointer so the graph stays movable, the once_flag itself can't move)
+    struct LazyNameIndex {
+        std::once_flag built;
+        std::unique_ptr<NameIndex> index;
+    };
+    std::unique_ptr<LazyNameIndex> nameIndex;
+
+    // Connected component of each dense index, numbered by size (0 is the largest)
+    // Built whenever the arrays change, so searches can rule out "no path" before starting
+    std::vector<int> componentIds;
+    std::vector<size_t> componentSizes;
+
+    // Point the spans at the owned vectors
+    void bindOwnedStorage();
+
+    // Hashes the arrays for the fingerprint, a full pass over them
+    std::uint64_t computeFingerprint() const;
+
+    // Label the components with a parallel union-find over the CSR arrays
+    void buildComponents();
+
+    // Sort every row of the owned adjacency arrays by target
+    void sortRows(unsigned int threadCount);
+
+    // Fill idLookup if actorIds isn't sorted, clear it otherwise
+    void buildIdLookup();
+
+    // Old dense index of every new index for a reverse Cuthill-McKee order
+    std::vector<int> cuthillMcKeeOrder() const;
+
+    // Get the name index, building it on first use (thread-safe)
+    const NameIndex& getNameIndex() const;
+
 public:
     // Constructor
     Graph();
@@ -60,12 +151,20 @@ public:
     // Destructor
     ~Graph();
 
+    // The spans may point into the graph itself, so copies aren't allowed (moves are fine)
+    Graph(const Graph&) = delete;
+    Graph& operator=(const Graph&) = delete;
+    Graph(Graph&&) = default;
+    Graph& operator=(Graph&&) = default;
+
     //=====================================================================================
     //                          Graph Building Methods
     //=====================================================================================
 
-    // Load the entire graph from database
-    void loadFromDatabase(SQLite::Database& db);
+    // Replace the graph with the one in a database (finalized, ready for queries)
+    // Edges are read in rowid ranges by threadCount threads (0 uses every core), each on
+    // its own read-only connection to the same file, and go straight into the CSR arrays
+    void loadFromDatabase(SQLite::Database& db, unsigned int threadCount = 0);
 
     // Add a single actor to the graph
     void addActor(int actorId, const std::string& actorName);
@@ -73,6 +172,44 @@ public:
     // Add an edge between two actors with a weight
     void addEdge(int actor1Id, int actor2Id, int weight);
 
+    // Builds the dense indices and CSR arrays from everything added so far
+    // Must be called after addActor/addEdge before running any queries
+    // (Indices follow ID order again afterwards, even if the graph had been reordered)
+    void finalize();
+
+    // Orders the dense indices can be renumbered in (see reorder())
+    enum class IndexOrder {
+        ActorId,        // Ascending actor ID, the order finalize() and loadFromDatabase() build
+        Degree,         // Most neighbors first, so the hubs nearly every search passes through share cache lines
+        CuthillMcKee    // Reverse Cuthill-McKee, breadth-first from low degree actors so neighbors get nearby indices
+    };
+
+    // Renumber the dense indices in the given order, so a search touches fewer cache lines
+    // and pages of the per-actor arrays. Actor IDs translate just as before, only the indices
+    // (and so the fingerprint) change. The graph owns its arrays afterwards, even if it was a snapshot.
+    void reorder(IndexOrder order);
+
+    //=====================================================================================
+    //                          Snapshot Methods
+    //=====================================================================================
+    // Binary snapshot of the finalized graph, so startup doesn't need to step through SQLite
+    // The file is versioned and checksummed, loading maps it and serves queries from it directly
+
+    // Write the finalized graph to a snapshot file, returns false on failure
+    bool saveSnapshot(const std::string& path) const;
+
+    // Replace the graph with a mapped snapshot file
+    // Returns false (and leaves the graph empty) if the file is missing, stale, or corrupt
+    bool loadSnapshot(const std::string& path, bool verifyChecksum = true);
+
+    // Whether the graph is currently served from a mapped snapshot
+    bool isSnapshot() const;
+
+    // Hash of the actor IDs and adjacency arrays (names aren't included)
+    // Files derived from the graph store it, to tell when they were built for a different graph
+    // It depends on the index order too, so reorder() changes it. Cached, so checking it is free.
+    std::uint64_t getFingerprint() const;
+
     //=====================================================================================
     //                          Query Methods
     //=====================================================================================
@@ -81,18 +218,19 @@ public:
     bool hasActor(int actorId) const;
 
     // Get actor by ID
-    const Actor* getActor(int actorId) const;
+    std::optional<Actor> getActor(int actorId) const;
 
     // Get actor by name (case-insensitive search)
-    const Actor* getActorByName(const std::string& name) const;
+    std::optional<Actor> getActorByName(const std::string& name) const;
 
-    // Search for actors by partial name match
-    std::vector<Actor> searchActorsByName(const std::string& partialName) const;
+    // Search for actors by partial name match (case-insensitive), best matches first
+    // maxResults of 0 returns every match
+    std::vector<Actor> searchActorsByName(const std::string& partialName, size_t maxResults = 0) const;
 
-    // Get all neighbors of an actor
-    const std::vector<Edge>* getNeighbors(int actorId) const;
+    // Get all neighbors of an actor (translated back to actor IDs)
+    std::vector<Edge> getNeighbors(int actorId) const;
 
-    // Get weight between two actors (0 if no edge)
+    // Get weight between two actors (0 if no edge), a binary search of the shorter row
     int getEdgeWeight(int actor1Id, int actor2Id) const;
 
     // Get total number of actors
@@ -104,6 +242,55 @@ public:
     // Get maximum weight in the graph
     int getMaxWeight() const;
 
+    //=====================================================================================
+    //                          Dense Index Methods
+    //=====================================================================================
+    // Used by the search algorithms, indices are only valid until the next finalize() or reorder()
+
+    // Get the dense index of an actor (-1 if not found)
+    int getIndex(int actorId) const;
+
+    // Get the actor ID stored at a dense index
+    int getActorId(int index) const;
+
+    // Get the actor stored at a dense index
+    Actor getActorByIndex(int index) const;
+
+    // Get the name of the actor stored at a dense index
+    std::string_view getName(int index) const;
+
+    // Neighbor indices and their weights for a dense index
+    std::span<const int> getNeighborIndices(int index) const;
+    std::span<const int> getNeighborWeights(int index) const;
+
+    // Number of neighbors of a dense index
+    size_t getDegree(int index) const;
+
+    // Total number of neighbor entries (each undirected edge is stored twice)
+    size_t getAdjacencySize() const;
+
+    // Weight of the edge between two dense indices (0 if no edge)
+    int getEdgeWeightByIndex(int index1, int index2) const;
+
+    // Weights of many (index1, index2) pairs at once, 0 where there is no edge or an index is -1
+    std::vector<int> getEdgeWeights(std::span<const std::pair<int, int>> indexPairs) const;
+
+    //=====================================================================================
+    //                          Component Methods
+    //=====================================================================================
+
+    // Connected component of a dense index, 0 being the largest
+    int getComponent(int index) const;
+
+    // Whether two dense indices are in the same component, i.e. some path joins them
+    bool areConnected(int index1, int index2) const;
+
+    // Number of connected components (isolated actors count as their own)
+    size_t getComponentCount() const;
+
+    // Actors in a component
+    size_t getComponentSize(int component) const;
+
     //=====================================================================================
     //                          Utility Methods
     //=====================================================================================
@@ -115,4 +302,12 @@ public:
     void clear();
 };
 
+//=====================================================================================
+//                              Graph Snapshot
+//=====================================================================================
+// A finalized graph shared by everything that reads it (searches, UI, analytics)
+// Only the const methods are reachable through it, and those are all safe to call from
+// any number of threads at once, so one load can serve the whole program
+using GraphSnapshot = std::shared_ptr<const Graph>;
+
 #endif // GRAPH_H
@@ -0,0 +1,432 @@
+#include "hopLabels.h"
+#include "checksum.h"
+#include <iostream>
+#include <format>
+#include <fstream>
+#include <chrono>
+#include <algorithm>
+#include <numeric>
+#include <thread>
+#include <atomic>
+
+//=====================================================================================
+//                              Constructor
+//=====================================================================================
+
+HopLabelIndex::HopLabelIndex() : actorCount(0), graphFingerprint(0), buildTimeMs(0.0) {
+}
+
+//=====================================================================================
+//                              Building
+//=====================================================================================
+
+namespace {
+    constexpr std::uint8_t UNREACHED = 255;
+
+    // Roots handled one at a time before the batches start, their BFSs are the big ones,
+    // and every later BFS prunes against them
+    constexpr int SEQUENTIAL_ROOTS = 256;
+
+    // Largest parallel batch, per thread
+    constexpr int MAX_BATCH_PER_THREAD = 128;
+
+    struct BuildEntry {
+        int hubRank;
+        std::uint8_t hops;
+        int parent;
+    };
+
+    // Scratch for one pruned BFS, each thread has its own
+    struct PrunedSearch {
+        std::vector<std::uint8_t> rootHops;     // By hub rank, hops from the root to the hubs in its label
+        std::vector<std::uint8_t> hops;         // By index, hops from the root in this BFS
+        std::vector<int> parent;
+        std::vector<int> queue;
+        bool overflow = false;
+
+        explicit PrunedSearch(size_t actorCount)
+            : rootHops(actorCount, UNREACHED), hops(actorCount, UNREACHED), parent(actorCount, -1) {
+        }
+    };
+
+    // BFS from the actor at rootRank, skipping (and not expanding) every actor whose current
+    // label already gives a distance to the root at least as short as this BFS found
+    // The new entries go to found, the labels themselves are only read
+    void runPrunedSearch(
+        const Graph& graph,
+        const std::vector<std::vector<BuildEntry>>& labels,
+        const std::vector<int>& rankToIndex,
+        int rootRank,
+        PrunedSearch& search,
+        std::vector<std::pair<int, BuildEntry>>& found
+    ) {
+        int root = rankToIndex[rootRank];
+        for (const BuildEntry& entry : labels[root]) {
+            search.rootHops[entry.hubRank] = entry.hops;
+        }
+
+        search.queue.clear();
+        search.queue.push_back(root);
+        search.hops[root] = 0;
+        search.parent[root] = -1;
+
+        for (size_t head = 0; head < search.queue.size(); head++) {
+            int current = search.queue[head];
+            int currentHops = search.hops[current];
+
+            // Pruned: some earlier hub already covers the root and this actor
+            bool covered = false;
+            for (const BuildEntry& entry : labels[current]) {
+                if (search.rootHops[entry.hubRank] != UNREACHED &&
+                    search.rootHops[entry.hubRank] + entry.hops <= currentHops) {
+                    covered = true;
+                    break;
+                }
+            }
+            if (covered) {
+                continue;
+            }
+
+            found.emplace_back(current, BuildEntry{ rootRank, static_cast<std::uint8_t>(currentHops), search.parent[current] });
+
+            if (currentHops == HopLabelIndex::MAX_HOPS) {
+                search.overflow = true;
+                continue;
+            }
+            for (int neighbor : graph.getNeighborIndices(current)) {
+                if (search.hops[neighbor] == UNREACHED) {
+                    search.hops[neighbor] = static_cast<std::uint8_t>(currentHops + 1);
+                    search.parent[neighbor] = current;
+                    search.queue.push_back(neighbor);
+                }
+            }
+        }
+
+        // Reset only what this BFS touched
+        for (int index : search.queue) {
+            search.hops[index] = UNREACHED;
+        }
+        for (const BuildEntry& entry : labels[root]) {
+            search.rootHops[entry.hubRank] = UNREACHED;
+        }
+    }
+}
+
+bool HopLabelIndex::build(const Graph& graph, unsigned int threadCount) {
+    auto startTime = std::chrono::high_resolution_clock::now();
+
+    *this = HopLabelIndex();
+    actorCount = graph.getActorCount();
+    graphFingerprint = graph.getFingerprint();
+    int count = static_cast<int>(actorCount);
+
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    // Rank actors by degree, highest first (ties by index so the order is reproducible)
+    rankToIndex.resize(actorCount);
+    std::iota(rankToIndex.begin(), rankToIndex.end(), 0);
+    std::stable_sort(rankToIndex.begin(), rankToIndex.end(), [&](int a, int b) {
+        return graph.getDegree(a) > graph.getDegree(b);
+    });
+
+    std::vector<std::vector<BuildEntry>> labels(actorCount);
+    std::vector<PrunedSearch> searches;
+    for (unsigned int t = 0; t < threadCount; t++) {
+        searches.emplace_back(actorCount);
+    }
+
+    // Roots go in batches, every BFS of a batch prunes against the labels of the earlier batches
+    // Batches grow as the BFSs get smaller, and with one thread every batch is a single root
+    std::vector<std::vector<std::pair<int, BuildEntry>>> batchFound;
+    int batchStart = 0;
+    while (batchStart < count) {
+        int batchSize = 1;
+        if (threadCount > 1 && batchStart >= SEQUENTIAL_ROOTS) {
+            batchSize = std::clamp(batchStart / 64, static_cast<int>(threadCount),
+                static_cast<int>(threadCount) * MAX_BATCH_PER_THREAD);
+        }
+        batchSize = std::min(batchSize, count - batchStart);
+        batchFound.resize(batchSize);
+
+        if (batchSize == 1) {
+            batchFound[0].clear();
+            runPrunedSearch(graph, labels, rankToIndex, batchStart, searches[0], batchFound[0]);
+        }
+        else {
+            // Threads take the next root of the batch until it runs out
+            std::atomic<int> nextSlot(0);
+            auto worker = [&](unsigned int t) {
+                for (int slot = nextSlot++; slot < batchSize; slot = nextSlot++) {
+                    batchFound[slot].clear();
+                    runPrunedSearch(graph, labels, rankToIndex, batchStart + slot, searches[t], batchFound[slot]);
+                }
+            };
+
+            std::vector<std::thread> threads;
+            for (unsigned int t = 1; t < std::min<unsigned int>(threadCount, batchSize); t++) {
+                threads.emplace_back(worker, t);
+            }
+            worker(0);
+            for (std::thread& thread : threads) {
+                thread.join();
+            }
+        }
+
+        // Appending in root order keeps every label sorted by hub rank
+        for (const auto& found : batchFound) {
+            for (const auto& [index, entry] : found) {
+                labels[index].push_back(entry);
+            }
+        }
+        batchStart += batchSize;
+    }
+
+    for (const PrunedSearch& search : searches) {
+        if (search.overflow) {
+            std::cerr << std::format("Error: Some hop distance is longer than {}, the hop labels can't hold it.\n", MAX_HOPS);
+            *this = HopLabelIndex();
+            return false;
+        }
+    }
+
+    // Pack the labels into CSR arrays
+    labelOffsets.assign(actorCount + 1, 0);
+    for (size_t index = 0; index < actorCount; index++) {
+        labelOffsets[index + 1] = labelOffsets[index] + labels[index].size();
+    }
+    labelHubs.reserve(labelOffsets.back());
+    labelHops.reserve(labelOffsets.back());
+    labelParents.reserve(labelOffsets.back());
+    for (auto& label : labels) {
+        for (const BuildEntry& entry : label) {
+            labelHubs.push_back(entry.hubRank);
+            labelHops.push_back(entry.hops);
+            labelParents.push_back(entry.parent);
+        }
+        std::vector<BuildEntry>().swap(label);
+    }
+
+    auto endTime = std::chrono::high_resolution_clock::now();
+    buildTimeMs = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+    return true;
+}
+
+//=====================================================================================
+//                              Label Files
+//=====================================================================================
+// File layout: a fixed header, then each array as its own section, padded to 8 bytes
+// Bump LABEL_FILE_VERSION on any layout change.
+
+namespace {
+    constexpr char LABEL_MAGIC[8] = { 'A', 'C', 'T', 'L', 'A', 'B', 'E', 'L' };
+    constexpr std::uint32_t LABEL_FILE_VERSION = 1;
+
+    struct LabelHeader {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t headerSize;       // Catches layout changes that forgot the version bump
+        std::uint64_t actorCount;
+        std::uint64_t entryCount;       // Label entries over all actors
+        std::uint64_t graphFingerprint; // Graph::getFingerprint() of the graph it was built for
+        std::uint64_t payloadChecksum;  // Over everything after the header
+    };
+    static_assert(sizeof(LabelHeader) % 8 == 0, "Label sections must stay 8 byte aligned");
+
+}
+
+bool HopLabelIndex::save(const std::string& path) const {
+    LabelHeader header{};
+    header.actorCount = actorCount;
+    header.entryCount = labelHubs.size();
+    header.graphFingerprint = graphFingerprint;
+
+    bool saved = writeFramedFile(path, "hop labels", LABEL_MAGIC, LABEL_FILE_VERSION, header,
+        [&](std::ofstream& file, std::uint64_t& checksum) {
+            writeSection(file, checksum, rankToIndex.data(), rankToIndex.size() * sizeof(int));
+            writeSection(file, checksum, labelOffsets.data(), labelOffsets.size() * sizeof(std::uint64_t));
+            writeSection(file, checksum, labelHubs.data(), labelHubs.size() * sizeof(int));
+            writeSection(file, checksum, labelParents.data(), labelParents.size() * sizeof(int));
+            writeSection(file, checksum, labelHops.data(), labelHops.size());
+        });
+    if (!saved) {
+        return false;
+    }
+
+    std::cout << std::format("Hop labels saved to {}\n", path);
+    return true;
+}
+
+bool HopLabelIndex::load(const std::string& path, const Graph& graph) {
+    auto startTime = std::chrono::high_resolution_clock::now();
+    *this = HopLabelIndex();
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    LabelHeader header;
+    if (!readFileHeader(file, path, "Hop label file", LABEL_MAGIC, LABEL_FILE_VERSION, header)) {
+        return false;
+    }
+
+    if (header.actorCount != graph.getActorCount() || header.graphFingerprint != graph.getFingerprint()) {
+        std::cerr << std::format("Warning: Hop label file {} was built for a different graph, ignoring it.\n", path);
+        return false;
+    }
+
+    if (!checkFileLayout<LabelHeader>(path, "Hop label file", { header.actorCount * sizeof(int),
+        (header.actorCount + 1) * sizeof(std::uint64_t), header.entryCount * sizeof(int),
+        header.entryCount * sizeof(int), header.entryCount })) {
+        return false;
+    }
+
+    HopLabelIndex loaded;
+    std::uint64_t checksum = CHECKSUM_SEED;
+    readSection(file, checksum, loaded.rankToIndex, header.actorCount);
+    readSection(file, checksum, loaded.labelOffsets, header.actorCount + 1);
+    readSection(file, checksum, loaded.labelHubs, header.entryCount);
+    readSection(file, checksum, loaded.labelParents, header.entryCount);
+    readSection(file, checksum, loaded.labelHops, header.entryCount);
+    if (!file || checksum != header.payloadChecksum) {
+        std::cerr << std::format("Warning: Hop label file {} failed its checksum, ignoring it.\n", path);
+        return false;
+    }
+
+    if (loaded.labelOffsets.front() != 0 || loaded.labelOffsets.back() != header.entryCount) {
+        std::cerr << std::format("Warning: Hop label file {} has inconsistent arrays, ignoring it.\n", path);
+        return false;
+    }
+
+    loaded.actorCount = header.actorCount;
+    loaded.graphFingerprint = header.graphFingerprint;
+    *this = std::move(loaded);
+
+    auto endTime = std::chrono::high_resolution_clock::now();
+    std::cout << std::format("Hop labels {} loaded in {:.1f} ms\n", path,
+        std::chrono::duration<double, std::milli>(endTime - startTime).count());
+    return true;
+}
+
+bool HopLabelIndex::empty() const {
+    return labelOffsets.empty();
+}
+
+//=====================================================================================
+//                              Query Methods
+//=====================================================================================
+
+bool HopLabelIndex::matches(const Graph& graph) const {
+    return !empty() && actorCount == graph.getActorCount() && graphFingerprint == graph.getFingerprint();
+}
+
+int HopLabelIndex::queryDistance(int startIndex, int endIndex) const {
+    // Both labels are sorted by hub rank, so shared hubs line up in one merge pass
+    std::uint64_t i = labelOffsets[startIndex];
+    std::uint64_t iEnd = labelOffsets[startIndex + 1];
+    std::uint64_t j = labelOffsets[endIndex];
+    std::uint64_t jEnd = labelOffsets[endIndex + 1];
+    int best = -1;
+
+    while (i < iEnd && j < jEnd) {
+        if (labelHubs[i] < labelHubs[j]) {
+            i++;
+        }
+        else if (labelHubs[i] > labelHubs[j]) {
+            j++;
+        }
+        else {
+            int hops = labelHops[i] + labelHops[j];
+            if (best == -1 || hops < best) {
+                best = hops;
+            }
+            i++;
+            j++;
+        }
+    }
+    return best;
+}
+
+std::vector<int> HopLabelIndex::queryPath(int startIndex, int endIndex) const {
+    // Same merge as queryDistance, but remembering which hub gave the best distance
+    std::uint64_t i = labelOffsets[startIndex];
+    std::uint64_t iEnd = labelOffsets[startIndex + 1];
+    std::uint64_t j = labelOffsets[endIndex];
+    std::uint64_t jEnd = labelOffsets[endIndex + 1];
+    int best = -1;
+    int bestHub = -1;
+
+    while (i < iEnd && j < jEnd) {
+        if (labelHubs[i] < labelHubs[j]) {
+            i++;
+        }
+        else if (labelHubs[i] > labelHubs[j]) {
+            j++;
+        }
+        else {
+            int hops = labelHops[i] + labelHops[j];
+            if (best == -1 || hops < best) {
+                best = hops;
+                bestHub = labelHubs[i];
+            }
+            i++;
+            j++;
+        }
+    }
+
+    std::vector<int> path;
+    if (bestHub == -1) {
+        return path;
+    }
+
+    // start -> hub, then end -> hub reversed (without the hub a second time)
+    std::vector<int> endHalf;
+    walkToHub(startIndex, bestHub, path);
+    walkToHub(endIndex, bestHub, endHalf);
+    path.insert(path.end(), endHalf.rbegin() + 1, endHalf.rend());
+    return path;
+}
+
+void HopLabelIndex::printStatistics() const {
+    std::cout << "\n=== Hop Label Statistics ===\n";
+    std::cout << std::format("Actors Labeled: {}\n", actorCount);
+    std::cout << std::format("Label Entries: {}\n", labelHubs.size());
+    if (actorCount > 0) {
+        std::cout << std::format("Average Label Size: {:.1f}\n", static_cast<double>(labelHubs.size()) / actorCount);
+    }
+    std::cout << std::format("Index Size: {} MB\n",
+        (labelHubs.size() * (2 * sizeof(int) + 1) + labelOffsets.size() * sizeof(std::uint64_t)) / (1024 * 1024));
+    if (buildTimeMs > 0.0) {
+        std::cout << std::format("Build Time: {:.1f} ms\n", buildTimeMs);
+    }
+    std::cout << "============================\n\n";
+}
+
+//=====================================================================================
+//                              Helper Methods
+//=====================================================================================
+
+std::int64_t HopLabelIndex::findEntry(int index, int hubRank) const {
+    auto begin = labelHubs.begin() + labelOffsets[index];
+    auto end = labelHubs.begin() + labelOffsets[index + 1];
+    auto it = std::lower_bound(begin, end, hubRank);
+    if (it == end || *it != hubRank) {
+        return -1;
+    }
+    return it - labelHubs.begin();
+}
+
+void HopLabelIndex::walkToHub(int index, int hubRank, std::vector<int>& path) const {
+    // Every actor on the way was reached by the same pruned BFS, so each has an entry for the hub
+    int current = index;
+    while (current != -1) {
+        path.push_back(current);
+        std::int64_t entry = findEntry(current, hubRank);
+        if (entry == -1) {
+            break;
+        }
+        current = labelParents[entry];
+    }
+}
@@ -0,0 +1,91 @@
+#ifndef HOPLABELS_H
+#define HOPLABELS_H
+
+#include "graph.h"
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+//=====================================================================================
+//                              HopLabelIndex Class
+//=====================================================================================
+// Pruned landmark labeling (Akiba et al.) over the unweighted actor graph, a 2-hop cover:
+// every actor v gets a label, a list of (hub, hops from v to hub) pairs, chosen so that for
+// any two actors some shortest path between them passes through a hub in both labels.
+// The hop distance is then the best hops(s, hub) + hops(t, hub) over their shared hubs,
+// found by merging the two sorted labels, in microseconds and without any search.
+//
+// Building runs one BFS per actor in order of degree (hubs first), and each BFS stops at
+// actors whose labels can already answer the distance to its root, so the busy actors
+// end up as the hubs of almost everyone and the labels stay short.
+// Each label entry also stores the next actor towards its hub, so paths can be rebuilt.
+//
+// The BFSs of one batch run in parallel and only prune against earlier batches, which
+// gives slightly longer labels than the sequential order but the same distances.
+// Like the landmarks, the index is saved next to the database and tied to its graph.
+class HopLabelIndex {
+public:
+    HopLabelIndex();
+
+    //=====================================================================================
+    //                          Building and Files
+    //=====================================================================================
+
+    // Build the labels (replaces the current index), threadCount of 0 uses every core
+    // Returns false (and leaves the index empty) if some distance doesn't fit in MAX_HOPS
+    bool build(const Graph& graph, unsigned int threadCount = 0);
+
+    // Write the index to a file, returns false on failure
+    bool save(const std::string& path) const;
+
+    // Replace the index with the one in a file
+    // Returns false (and leaves the index empty) if the file is missing, corrupt, or built for another graph
+    bool load(const std::string& path, const Graph& graph);
+
+    // Whether there is anything to use (false before build/load)
+    bool empty() const;
+
+    //=====================================================================================
+    //                          Query Methods
+    //=====================================================================================
+
+    // Whether the index was built for this graph, by fingerprint (a reordered graph has the same
+    // actors but different indices, so the actor count alone isn't enough)
+    bool matches(const Graph& graph) const;
+
+    // Hop distance between two dense indices, -1 if they aren't connected
+    int queryDistance(int startIndex, int endIndex) const;
+
+    // A shortest path between two dense indices (as dense indices, start first), empty if not connected
+    std::vector<int> queryPath(int startIndex, int endIndex) const;
+
+    // Average label length and total size
+    void printStatistics() const;
+
+    // Longest distance a label entry can hold
+    static constexpr int MAX_HOPS = 254;
+
+private:
+    // Labels in CSR form, the label of index v is entries [labelOffsets[v] .. labelOffsets[v + 1])
+    // sorted by hub rank (rank 0 is the highest degree actor)
+    std::vector<std::uint64_t> labelOffsets;
+    std::vector<int> labelHubs;             // Hub, as its rank
+    std::vector<std::uint8_t> labelHops;    // Hops from v to the hub
+    std::vector<int> labelParents;          // Next index from v towards the hub, -1 at the hub itself
+
+    // Dense index of the actor at each rank
+    std::vector<int> rankToIndex;
+
+    size_t actorCount;
+    std::uint64_t graphFingerprint;
+    double buildTimeMs;
+
+    // Position of a hub in the label of index, or -1
+    std::int64_t findEntry(int index, int hubRank) const;
+
+    // Appends the walk from index to the hub (both included) to path
+    void walkToHub(int index, int hubRank, std::vector<int>& path) const;
+};
+
+#endif // HOPLABELS_H
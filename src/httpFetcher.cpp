@@ -0,0 +1,259 @@
+#include "httpFetcher.h"
+#include "rateLimiter.h"
+#include <curl/curl.h>
+#include <iostream>
+#include <format>
+#include <mutex>
+#include <memory>
+#include <algorithm>
+#include <deque>
+#include <chrono>
+
+namespace {
+    // curl_global_init isn't thread-safe, so every fetcher goes through this once
+    bool initializeCurl() {
+        static std::once_flag initialized;
+        static bool succeeded = false;
+        std::call_once(initialized, []() {
+            succeeded = curl_global_init(CURL_GLOBAL_DEFAULT) == CURLE_OK;
+        });
+        return succeeded;
+    }
+
+    size_t appendBody(void* contents, size_t size, size_t nmemb, void* userp) {
+        size_t totalSize = size * nmemb;
+        static_cast<std::string*>(userp)->append(static_cast<const char*>(contents), totalSize);
+        return totalSize;
+    }
+
+    // A request on its way, found again from its easy handle through CURLOPT_PRIVATE
+    struct Transfer {
+        size_t index;
+        HttpResponse response;
+        char errorBuffer[CURL_ERROR_SIZE];
+    };
+}
+
+//=====================================================================================
+//                          Constructor & Destructor
+//=====================================================================================
+
+HttpFetcher::HttpFetcher(int maxInFlight)
+    : multi(nullptr), rateLimiter(nullptr), maxInFlight(std::max(1, maxInFlight)), requestCount(0), connectionCount(0), usable(false) {
+    if (!initializeCurl()) {
+        std::cerr << "Failed to initialize CURL.\n";
+        return;
+    }
+    if (!(curl_version_info(CURLVERSION_NOW)->features & CURL_VERSION_SSL)) {
+        std::cerr << "\nFATAL cURL ERROR: SSL support is missing. Cannot use HTTPS. Ensure cURL is built with SCHANNEL or OpenSSL.\n";
+        return;
+    }
+
+    CURLM* handle = curl_multi_init();
+    if (handle == nullptr) {
+        std::cerr << "Failed to initialize CURL.\n";
+        return;
+    }
+
+    // Keep one open connection per request slot, so the pool never has to close one to open another
+    curl_multi_setopt(handle, CURLMOPT_MAXCONNECTS, static_cast<long>(this->maxInFlight));
+    curl_multi_setopt(handle, CURLMOPT_MAX_HOST_CONNECTIONS, static_cast<long>(this->maxInFlight));
+    multi = handle;
+    usable = true;
+}
+
+HttpFetcher::~HttpFetcher() {
+    for (void* handle : idleHandles) {
+        curl_easy_cleanup(static_cast<CURL*>(handle));
+    }
+    if (multi != nullptr) {
+        curl_multi_cleanup(static_cast<CURLM*>(multi));
+    }
+}
+
+//=====================================================================================
+//                          Fetch Methods
+//=====================================================================================
+
+HttpResponse HttpFetcher::fetch(const std::string& url) {
+    std::vector<HttpResponse> responses = fetchAll(std::vector<std::string>{ url });
+    return std::move(responses.front());
+}
+
+std::vector<HttpResponse> HttpFetcher::fetchAll(const std::vector<std::string>& urls) {
+    std::vector<HttpResponse> responses(urls.size());
+    fetchAll(urls, [&](size_t index, HttpResponse& response) {
+        responses[index] = std::move(response);
+    });
+    return responses;
+}
+
+void HttpFetcher::fetchAll(const std::vector<std::string>& urls, const std::function<void(size_t, HttpResponse&)>& onResponse) {
+    if (!usable) {
+        for (size_t index = 0; index < urls.size(); index++) {
+            HttpResponse response;
+            response.url = urls[index];
+            response.error = "cURL is not available";
+            onResponse(index, response);
+        }
+        return;
+    }
+
+    CURLM* multiHandle = static_cast<CURLM*>(multi);
+    std::deque<size_t> waiting; // URL indices still to send, rate limited ones go back in at the end
+    for (size_t index = 0; index < urls.size(); index++) {
+        waiting.push_back(index);
+    }
+    std::vector<int> attempts(urls.size(), 0);
+    int inFlight = 0;
+
+    while (!waiting.empty() || inFlight > 0) {
+        // Step 1: Top the transfers back up to maxInFlight, as far as the rate limiter allows
+        std::chrono::milliseconds tokenWait(0);
+        while (inFlight < maxInFlight && !waiting.empty()) {
+            if (rateLimiter != nullptr) {
+                tokenWait = rateLimiter->tryAcquire();
+                if (tokenWait.count() > 0) {
+                    break;
+                }
+            }
+
+            size_t index = waiting.front();
+            waiting.pop_front();
+            attempts[index]++;
+
+            auto transfer = std::make_unique<Transfer>();
+            transfer->index = index;
+            transfer->response.url = urls[index];
+            transfer->errorBuffer[0] = '\0';
+
+            CURL* handle = static_cast<CURL*>(acquireHandle());
+            if (handle == nullptr) {
+                transfer->response.error = "Failed to initialize CURL.";
+                onResponse(transfer->index, transfer->response);
+                continue;
+            }
+            curl_easy_setopt(handle, CURLOPT_URL, urls[index].c_str());
+            curl_easy_setopt(handle, CURLOPT_WRITEDATA, &transfer->response.body);
+            curl_easy_setopt(handle, CURLOPT_ERRORBUFFER, transfer->errorBuffer);
+            curl_easy_setopt(handle, CURLOPT_PRIVATE, transfer.release());
+            curl_multi_add_handle(multiHandle, handle);
+            inFlight++;
+        }
+
+        // Step 2: Move every transfer along
+        int running = 0;
+        curl_multi_perform(multiHandle, &running);
+
+        // Step 3: Hand back the finished ones, their handles go back to the pool still connected
+        bool slotFreed = false;
+        int queued = 0;
+        while (CURLMsg* message = curl_multi_info_read(multiHandle, &queued)) {
+            if (message->msg != CURLMSG_DONE) {
+                continue;
+            }
+
+            CURL* handle = message->easy_handle;
+            char* privateData = nullptr;
+            curl_easy_getinfo(handle, CURLINFO_PRIVATE, &privateData);
+            std::unique_ptr<Transfer> transfer(reinterpret_cast<Transfer*>(privateData));
+
+            long connects = 0;
+            curl_easy_getinfo(handle, CURLINFO_NUM_CONNECTS, &connects);
+            connectionCount += static_cast<size_t>(connects);
+            requestCount++;
+
+            if (message->data.result == CURLE_OK) {
+                curl_off_t retryAfter = 0;
+                curl_easy_getinfo(handle, CURLINFO_RESPONSE_CODE, &transfer->response.status);
+                curl_easy_getinfo(handle, CURLINFO_RETRY_AFTER, &retryAfter);
+                transfer->response.retryAfterSeconds = static_cast<long>(retryAfter);
+            }
+            else {
+                transfer->response.error = transfer->errorBuffer[0] != '\0'
+                    ? std::string(transfer->errorBuffer)
+                    : std::string(curl_easy_strerror(message->data.result));
+                std::cerr << std::format("cURL failed: {}\n", transfer->response.error);
+            }
+
+            curl_multi_remove_handle(multiHandle, handle);
+            curl_easy_setopt(handle, CURLOPT_PRIVATE, nullptr);
+            idleHandles.push_back(handle);
+            inFlight--;
+            slotFreed = true;
+
+            if (rateLimiter != nullptr) {
+                if (transfer->response.status == 429) {
+                    rateLimiter->onRateLimited(transfer->response.retryAfterSeconds);
+                    if (attempts[transfer->index] <= MAX_RETRIES) {
+                        waiting.push_back(transfer->index);
+                        continue;
+                    }
+                }
+                else if (transfer->response.ok()) {
+                    rateLimiter->onSuccess();
+                }
+            }
+
+            onResponse(transfer->index, transfer->response);
+        }
+
+        // Step 4: Sleep until a socket is ready or the next token is, unless a finished transfer
+        // left a slot to fill right away
+        bool canSend = !waiting.empty() && inFlight < maxInFlight;
+        if (canSend && slotFreed) {
+            continue;
+        }
+        if (inFlight > 0 || canSend) {
+            long timeout = 1000;
+            if (canSend && tokenWait.count() > 0) {
+                timeout = std::min<long>(timeout, static_cast<long>(tokenWait.count()));
+            }
+            curl_multi_poll(multiHandle, nullptr, 0, static_cast<int>(timeout), nullptr);
+        }
+    }
+}
+
+void* HttpFetcher::acquireHandle() {
+    if (!idleHandles.empty()) {
+        void* handle = idleHandles.back();
+        idleHandles.pop_back();
+        return handle;
+    }
+
+    CURL* handle = curl_easy_init();
+    if (handle == nullptr) {
+        return nullptr;
+    }
+    curl_easy_setopt(handle, CURLOPT_WRITEFUNCTION, appendBody);
+    curl_easy_setopt(handle, CURLOPT_ACCEPT_ENCODING, ""); // Any compression cURL supports
+    curl_easy_setopt(handle, CURLOPT_TCP_KEEPALIVE, 1L);
+    curl_easy_setopt(handle, CURLOPT_CONNECTTIMEOUT, 15L);
+    curl_easy_setopt(handle, CURLOPT_TIMEOUT, 60L);
+    curl_easy_setopt(handle, CURLOPT_NOSIGNAL, 1L); // Timeouts without signals, for use off the main thread
+    return handle;
+}
+
+//=====================================================================================
+//                          Accessors
+//=====================================================================================
+
+void HttpFetcher::setRateLimiter(RateLimiter* limiter) {
+    rateLimiter = limiter;
+}
+
+int HttpFetcher::getMaxInFlight() const {
+    return maxInFlight;
+}
+
+size_t HttpFetcher::getRequestCount() const {
+    return requestCount;
+}
+
+size_t HttpFetcher::getConnectionCount() const {
+    return connectionCount;
+}
+
+bool HttpFetcher::isUsable() const {
+    return usable;
+}
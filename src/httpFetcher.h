@@ -0,0 +1,89 @@
+#ifndef HTTPFETCHER_H
+#define HTTPFETCHER_H
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <cstddef>
+
+class RateLimiter;
+
+//=====================================================================================
+//                              HTTP Response Structure
+//=====================================================================================
+// Result of one GET request
+struct HttpResponse {
+    std::string url;
+    long status;            // HTTP status code, 0 if the transfer itself failed
+    std::string body;
+    std::string error;      // cURL's error message when the transfer failed, empty otherwise
+    long retryAfterSeconds; // The server's Retry-After header (seconds or a date), 0 if it didn't send one
+
+    HttpResponse() : status(0), retryAfterSeconds(0) {}
+
+    // Whether a response came back with a 2xx status
+    bool ok() const { return status >= 200 && status < 300; }
+};
+
+//=====================================================================================
+//                              HttpFetcher Class
+//=====================================================================================
+// Runs many GET requests at once on a single curl_multi handle
+// Easy handles are kept in a pool and reused, so once a connection to a host is open
+// (TCP + TLS handshake done) every later request to that host goes over it (HTTP keep-alive).
+// A fetcher is not thread-safe, give each thread its own.
+//
+// With a rate limiter set, every request (retries included) waits for a token first, and
+// responses are reported back to it. A 429 pauses the limiter and the request goes back in
+// line, up to MAX_RETRIES times before it is handed over as it is.
+class HttpFetcher {
+public:
+    // Requests in flight at once when none is given
+    static constexpr int DEFAULT_MAX_IN_FLIGHT = 8;
+
+    // Times a rate limited request is sent again before giving up on it
+    static constexpr int MAX_RETRIES = 4;
+
+    explicit HttpFetcher(int maxInFlight = DEFAULT_MAX_IN_FLIGHT);
+    ~HttpFetcher();
+
+    // Owns cURL handles, so it can't be copied
+    HttpFetcher(const HttpFetcher&) = delete;
+    HttpFetcher& operator=(const HttpFetcher&) = delete;
+
+    // Fetch a single URL (still reusing the pooled connections)
+    HttpResponse fetch(const std::string& url);
+
+    // Fetch every URL with up to maxInFlight requests at a time, calling onResponse(index, response)
+    // on this thread as each one finishes (in completion order, not URL order)
+    void fetchAll(const std::vector<std::string>& urls, const std::function<void(size_t, HttpResponse&)>& onResponse);
+
+    // Same, collecting the responses in URL order
+    std::vector<HttpResponse> fetchAll(const std::vector<std::string>& urls);
+
+    // Pace requests with a limiter (can be shared with other fetchers), nullptr turns pacing off
+    void setRateLimiter(RateLimiter* limiter);
+
+    int getMaxInFlight() const;
+
+    // Requests finished, and the new connections they needed (the rest reused an open one)
+    size_t getRequestCount() const;
+    size_t getConnectionCount() const;
+
+    // Whether cURL was set up and built with HTTPS support, nothing can be fetched otherwise
+    bool isUsable() const;
+
+private:
+    void* multi; // CURLM*, kept opaque so cURL's header stays out of this one
+    std::vector<void*> idleHandles; // CURL* handles waiting for their next request
+    RateLimiter* rateLimiter;
+    int maxInFlight;
+    size_t requestCount;
+    size_t connectionCount;
+    bool usable;
+
+    // Take an easy handle from the pool, or make a new one with the shared options
+    void* acquireHandle();
+};
+
+#endif // HTTPFETCHER_H
@@ -0,0 +1,209 @@
+#include "landmarks.h"
+#include "dijkstra.h"
+#include "checksum.h"
+#include <iostream>
+#include <format>
+#include <fstream>
+#include <chrono>
+
+//=====================================================================================
+//                              Constructor
+//=====================================================================================
+
+LandmarkIndex::LandmarkIndex() : landmarkCount(0), actorCount(0), graphFingerprint(0), buildTimeMs(0.0) {
+}
+
+//=====================================================================================
+//                              Building
+//=====================================================================================
+
+void LandmarkIndex::build(const Graph& graph, int count) {
+    auto startTime = std::chrono::high_resolution_clock::now();
+
+    landmarks.clear();
+    costs.clear();
+    actorCount = graph.getActorCount();
+    graphFingerprint = graph.getFingerprint();
+    landmarkCount = 0;
+
+    if (actorCount == 0 || count <= 0) {
+        return;
+    }
+
+    // Cost from each actor to its closest landmark so far, infinity until some landmark reaches it
+    std::vector<double> nearest(actorCount, INFINITE_COST);
+    std::vector<std::vector<double>> tables;
+
+    for (int k = 0; k < count; k++) {
+        int chosen = -1;
+        if (k == 0) {
+            // Start from the best connected actor, which sits in the main component
+            size_t bestDegree = 0;
+            for (int index = 0; index < static_cast<int>(actorCount); index++) {
+                if (chosen == -1 || graph.getDegree(index) > bestDegree) {
+                    chosen = index;
+                    bestDegree = graph.getDegree(index);
+                }
+            }
+        }
+        else {
+            // Farthest reachable actor from every landmark so far (unreachable ones would only
+            // ever help inside their own small component)
+            double farthest = 0.0;
+            for (int index = 0; index < static_cast<int>(actorCount); index++) {
+                if (nearest[index] != INFINITE_COST && nearest[index] > farthest) {
+                    chosen = index;
+                    farthest = nearest[index];
+                }
+            }
+            if (chosen == -1) {
+                break; // Every reachable actor is already a landmark
+            }
+        }
+
+        CostTable table = Dijkstra::computeCostTable(graph, graph.getActorId(chosen));
+        for (size_t index = 0; index < actorCount; index++) {
+            nearest[index] = std::min(nearest[index], table.cost[index]);
+        }
+        landmarks.push_back(chosen);
+        tables.push_back(std::move(table.cost));
+    }
+
+    // Regroup the tables by actor, so a bound reads one contiguous row
+    landmarkCount = static_cast<int>(landmarks.size());
+    costs.resize(actorCount * landmarkCount);
+    for (size_t index = 0; index < actorCount; index++) {
+        for (int k = 0; k < landmarkCount; k++) {
+            costs[index * landmarkCount + k] = tables[k][index];
+        }
+    }
+
+    auto endTime = std::chrono::high_resolution_clock::now();
+    buildTimeMs = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+}
+
+//=====================================================================================
+//                              Landmark Files
+//=====================================================================================
+// File layout: a fixed header, the landmark indices (padded to 8 bytes), then the cost rows
+// Bump LANDMARK_FILE_VERSION on any layout change.
+
+namespace {
+    constexpr char LANDMARK_MAGIC[8] = { 'A', 'C', 'T', 'L', 'M', 'A', 'R', 'K' };
+    constexpr std::uint32_t LANDMARK_FILE_VERSION = 1;
+
+    struct LandmarkHeader {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t headerSize;       // Catches layout changes that forgot the version bump
+        std::uint64_t actorCount;
+        std::uint32_t landmarkCount;
+        std::uint32_t reserved;
+        std::uint64_t graphFingerprint; // Graph::getFingerprint() of the graph it was built for
+        std::uint64_t payloadChecksum;  // Over everything after the header
+    };
+    static_assert(sizeof(LandmarkHeader) % 8 == 0, "Landmark costs must stay 8 byte aligned");
+}
+
+bool LandmarkIndex::save(const std::string& path) const {
+    LandmarkHeader header{};
+    header.actorCount = actorCount;
+    header.landmarkCount = landmarkCount;
+    header.graphFingerprint = graphFingerprint;
+
+    bool saved = writeFramedFile(path, "landmarks", LANDMARK_MAGIC, LANDMARK_FILE_VERSION, header,
+        [&](std::ofstream& file, std::uint64_t& checksum) {
+            writeSection(file, checksum, landmarks.data(), landmarks.size() * sizeof(int));
+            writeSection(file, checksum, costs.data(), costs.size() * sizeof(double));
+        });
+    if (!saved) {
+        return false;
+    }
+
+    std::cout << std::format("Landmarks saved to {}\n", path);
+    return true;
+}
+
+bool LandmarkIndex::load(const std::string& path, const Graph& graph) {
+    auto startTime = std::chrono::high_resolution_clock::now();
+    *this = LandmarkIndex();
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    LandmarkHeader header;
+    if (!readFileHeader(file, path, "Landmark file", LANDMARK_MAGIC, LANDMARK_FILE_VERSION, header)) {
+        return false;
+    }
+
+    if (header.actorCount != graph.getActorCount() || header.graphFingerprint != graph.getFingerprint()) {
+        std::cerr << std::format("Warning: Landmark file {} was built for a different graph, ignoring it.\n", path);
+        return false;
+    }
+
+    if (!checkFileLayout<LandmarkHeader>(path, "Landmark file", { header.landmarkCount * sizeof(int),
+        header.actorCount * header.landmarkCount * sizeof(double) })) {
+        return false;
+    }
+
+    std::vector<int> fileLandmarks;
+    std::vector<double> fileCosts;
+    std::uint64_t checksum = CHECKSUM_SEED;
+    readSection(file, checksum, fileLandmarks, header.landmarkCount);
+    readSection(file, checksum, fileCosts, header.actorCount * header.landmarkCount);
+    if (!file || checksum != header.payloadChecksum) {
+        std::cerr << std::format("Warning: Landmark file {} failed its checksum, ignoring it.\n", path);
+        return false;
+    }
+
+    for (int index : fileLandmarks) {
+        if (index < 0 || static_cast<std::uint64_t>(index) >= header.actorCount) {
+            std::cerr << std::format("Warning: Landmark file {} has inconsistent landmarks, ignoring it.\n", path);
+            return false;
+        }
+    }
+
+    landmarks = std::move(fileLandmarks);
+    costs = std::move(fileCosts);
+    landmarkCount = static_cast<int>(header.landmarkCount);
+    actorCount = header.actorCount;
+    graphFingerprint = header.graphFingerprint;
+
+    auto endTime = std::chrono::high_resolution_clock::now();
+    std::cout << std::format("Landmarks {} loaded in {:.1f} ms\n", path,
+        std::chrono::duration<double, std::milli>(endTime - startTime).count());
+    return true;
+}
+
+bool LandmarkIndex::empty() const {
+    return landmarkCount == 0;
+}
+
+//=====================================================================================
+//                              Query Methods
+//=====================================================================================
+
+bool LandmarkIndex::matches(const Graph& graph) const {
+    return !empty() && actorCount == graph.getActorCount() && graphFingerprint == graph.getFingerprint();
+}
+
+const std::vector<int>& LandmarkIndex::getLandmarks() const {
+    return landmarks;
+}
+
+double LandmarkIndex::getCost(int landmark, int index) const {
+    return costs[static_cast<size_t>(index) * landmarkCount + landmark];
+}
+
+void LandmarkIndex::printStatistics() const {
+    std::cout << "\n=== Landmark Statistics ===\n";
+    std::cout << std::format("Landmarks: {}\n", landmarkCount);
+    std::cout << std::format("Actors Covered: {}\n", actorCount);
+    std::cout << std::format("Table Size: {} MB\n", costs.size() * sizeof(double) / (1024 * 1024));
+    if (buildTimeMs > 0.0) {
+        std::cout << std::format("Build Time: {:.1f} ms\n", buildTimeMs);
+    }
+    std::cout << "===========================\n\n";
+}
@@ -0,0 +1,106 @@
+#ifndef LANDMARKS_H
+#define LANDMARKS_H
+
+#include "graph.h"
+#include <vector>
+#include <string>
+#include <limits>
+#include <cstdint>
+#include <cstddef>
+#include <cmath>
+#include <algorithm>
+
+//=====================================================================================
+//                              LandmarkIndex Class
+//=====================================================================================
+// Precomputed strongest-path costs (Dijkstra's inverted weights) from a few landmark
+// actors to every actor, for A* searches (ALT: A*, Landmarks, Triangle inequality).
+// For any landmark L, the triangle inequality gives |cost(L, t) - cost(L, v)| <= cost(v, t),
+// so the best of those differences is a lower bound that never overestimates and
+// steers the search towards the target.
+//
+// Landmarks are picked by farthest-point selection: the highest degree actor first, then
+// each next one is the actor farthest from every landmark chosen so far, so they end up
+// around the edges of the graph where their bounds are tightest.
+//
+// Building takes one full Dijkstra per landmark, so it's done once per database build
+// and saved to disk. The file remembers the graph's fingerprint, and is rejected if it
+// was built for a different graph.
+class LandmarkIndex {
+public:
+    LandmarkIndex();
+
+    // Number of landmarks used when none is given, more gives tighter bounds but costs
+    // 8 bytes per actor each, and more work per bound
+    static constexpr int DEFAULT_LANDMARK_COUNT = 16;
+
+    //=====================================================================================
+    //                          Building and Files
+    //=====================================================================================
+
+    // Pick the landmarks and compute their cost to every actor (replaces the current index)
+    void build(const Graph& graph, int count = DEFAULT_LANDMARK_COUNT);
+
+    // Write the index to a file, returns false on failure
+    bool save(const std::string& path) const;
+
+    // Replace the index with the one in a file
+    // Returns false (and leaves the index empty) if the file is missing, corrupt, or built for another graph
+    bool load(const std::string& path, const Graph& graph);
+
+    // Whether there is anything to use (false before build/load)
+    bool empty() const;
+
+    //=====================================================================================
+    //                          Query Methods
+    //=====================================================================================
+
+    // Whether the index was built for this graph, by fingerprint (a reordered graph has the same
+    // actors but different indices, so the actor count alone isn't enough)
+    bool matches(const Graph& graph) const;
+
+    // Lower bound on the strongest-path cost between two dense indices
+    // Infinity when a landmark reaches exactly one of them (they're in different components)
+    double lowerBound(int index, int targetIndex) const {
+        const double* from = &costs[static_cast<size_t>(index) * landmarkCount];
+        const double* to = &costs[static_cast<size_t>(targetIndex) * landmarkCount];
+        double bound = 0.0;
+        for (int k = 0; k < landmarkCount; k++) {
+            bool fromReached = from[k] != INFINITE_COST;
+            bool toReached = to[k] != INFINITE_COST;
+            if (fromReached != toReached) {
+                return INFINITE_COST;
+            }
+            if (fromReached) {
+                bound = std::max(bound, std::abs(from[k] - to[k]));
+            }
+        }
+        return bound;
+    }
+
+    // Landmarks as dense indices, in the order they were picked
+    const std::vector<int>& getLandmarks() const;
+
+    // Cost from one landmark (by position in getLandmarks()) to a dense index, infinity if unreachable
+    double getCost(int landmark, int index) const;
+
+    // Print how many landmarks there are and how long the build took
+    void printStatistics() const;
+
+    static constexpr double INFINITE_COST = std::numeric_limits<double>::infinity();
+
+private:
+    // Dense indices of the landmarks
+    std::vector<int> landmarks;
+
+    // Landmark costs grouped by actor, costs[index * landmarkCount + k] is cost(landmark k, index)
+    // so one bound reads one contiguous row per actor
+    std::vector<double> costs;
+
+    int landmarkCount;
+    size_t actorCount;
+    std::uint64_t graphFingerprint;
+    double buildTimeMs;
+};
+
+#endif // LANDMARKS_H
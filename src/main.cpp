@@ -25,14 +25,25 @@
 #include "dijkstra.h"
 #include "dataCollection.h"
 #include "config.h"
+#include "benchmark.h"
 
 //		Organization of Files:
 // src/			        : All source code files
 //     main.cpp         : Main entry point of the program
 //     window.h/cpp     : Window creation and management
 //     graph.h/cpp      : Graph data structure implementation, graph is weighted, and can be called unweighted. Nodes are weighted for visual usage
+//     mappedFile.h/cpp : Read-only memory mapped files, used to load the binary graph snapshot
+//     nameIndex.h/cpp  : Trigram and exact name index behind the actor name searches
 //     bfs.h/cpp	    : Breadth-First Search algorithm implementation
 //     dijkstra.h/cpp   : Dijkstra's algorithm implementation
+//     landmarks.h/cpp  : Landmark costs (ALT) that guide the A* strongest path search, saved next to the database
+//     contractionHierarchy.h/cpp : Contraction hierarchy with shortcuts for the strongest path search, saved next to the database
+//     hopLabels.h/cpp  : Pruned landmark labeling, answers hop distances without searching, saved next to the database
+//     checksum.h       : Checksum shared by the binary files saved next to the database
+//     queryWorkspace.h/cpp : Per-thread scratch arrays reused by every search, so queries don't allocate
+//     bitmap.h         : Packed bitset of actors, used by the BFS engines
+//     priorityQueues.h : Binary, 4-ary and radix heaps the Dijkstra search can run on
+//     benchmark.h/cpp  : Developer benchmarks, comparing the faster search modes against the original ones
 //     config.h/cpp     : Handles config settings
 //     dataCollection.h : Data collection and file creation from TMDB API, also collects images for use in window. Used to manage vector of actors as well.
 // ----------------------------------------------------------------------------------------------------------------
@@ -57,6 +68,22 @@ int main() {
 
 	//SQLite::Database db = openMainDatabase();
 	//loadActorDataFromDB(db);
+	//compareDatabaseLoad(db);
+
+	//Benchmarks - Uncomment to check the faster search modes against the original ones
+	//const Graph& graph = *getMainGraphSnapshot();
+	//compareBFSModes(graph);
+	//compareDijkstraModes(graph);
+	//compareParallelCostTable(graph);
+	//compareLandmarkSearch(graph, loadMainLandmarks(graph));
+	//compareContractionHierarchy(graph, loadMainContractionHierarchy(graph));
+	//compareHopLabels(graph, loadMainHopLabels(graph));
+	//compareParallelDistanceTable(graph);
+	//compareDistanceMatrix(graph);
+	//Graph reorderGraph = loadMainGraph();
+	//compareIndexOrders(reorderGraph);
+	//recordSampleResponses(2010, 100, "responses");
+	//compareJsonExtraction("responses");
 
 	
 	//Data Collection Code - Uncomment to run data collection separately
@@ -0,0 +1,43 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <string>
+#include <cstddef>
+
+//=====================================================================================
+//                              MappedFile Class
+//=====================================================================================
+// Read-only memory mapping of a whole file (mmap on Linux/macOS, file mappings on Windows)
+// Pages are loaded lazily by the OS, so opening even a huge file is nearly instant
+class MappedFile {
+public:
+    MappedFile();
+    ~MappedFile();
+
+    // Mappings own OS handles, so they can't be copied
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Map the file at path, returns false if it doesn't exist or can't be mapped
+    bool open(const std::string& path);
+
+    // Unmap the file (also done by the destructor)
+    void close();
+
+    bool isOpen() const;
+    const std::byte* data() const;
+    size_t size() const;
+
+private:
+    const std::byte* mappedData;
+    size_t mappedSize;
+
+#ifdef _WIN32
+    void* fileHandle;
+    void* mappingHandle;
+#else
+    int fileDescriptor;
+#endif
+};
+
+#endif // MAPPEDFILE_H
@@ -0,0 +1,244 @@
+#include "movieWriter.h"
+#include <iostream>
+#include <format>
+#include <algorithm>
+
+namespace {
+    // "<prefix> (?, ?), (?, ?), ... <suffix>" with rowCount rows of two values
+    std::string multiRowSql(const char* prefix, size_t rowCount, const char* suffix) {
+        std::string sql = prefix;
+        for (size_t row = 0; row < rowCount; row++) {
+            sql += row == 0 ? " (?, ?)" : ", (?, ?)";
+        }
+        sql += suffix;
+        return sql;
+    }
+
+    constexpr const char* INSERT_MOVIES = "INSERT OR IGNORE INTO Movies (movie_id, title) VALUES";
+    constexpr const char* INSERT_ACTORS = "INSERT OR IGNORE INTO Actors (actor_id, actor_name) VALUES";
+    constexpr const char* INSERT_LINKS = "INSERT INTO Cast_Links (movie_id, actor_id) VALUES";
+    constexpr const char* LINKS_SUFFIX = " ON CONFLICT DO NOTHING;";
+}
+
+//=====================================================================================
+//                          Constructor & Destructor
+//=====================================================================================
+
+MovieWriter::MovieWriter(SQLite::Database& db, size_t moviesPerCommit, std::chrono::milliseconds maxCommitDelay)
+    : db(db), moviesPerCommit(std::max<size_t>(1, moviesPerCommit)), maxCommitDelay(maxCommitDelay),
+    inTransaction(false), transactionMovies(0), transactionCredits(0), transactionRows(0),
+    moviesWritten(0), creditsWritten(0), rowsWritten(0), commitCount(0), failedCommits(0), writeSeconds(0.0) {
+    // WAL appends commits to a log instead of rewriting pages in place, and with synchronous=NORMAL
+    // it only syncs at checkpoints, which is still safe from corruption (a crash can only lose the last commits)
+    db.exec("PRAGMA journal_mode=WAL;");
+    db.exec("PRAGMA synchronous=NORMAL;");
+    db.exec(std::format("PRAGMA cache_size=-{};", CACHE_SIZE_KIB));
+
+    insertMovies = std::make_unique<SQLite::Statement>(db, multiRowSql(INSERT_MOVIES, ROWS_PER_INSERT, ";"));
+    insertActors = std::make_unique<SQLite::Statement>(db, multiRowSql(INSERT_ACTORS, ROWS_PER_INSERT, ";"));
+    insertLinks = std::make_unique<SQLite::Statement>(db, multiRowSql(INSERT_LINKS, ROWS_PER_INSERT, LINKS_SUFFIX));
+    insertMovie = std::make_unique<SQLite::Statement>(db, multiRowSql(INSERT_MOVIES, 1, ";"));
+    insertActor = std::make_unique<SQLite::Statement>(db, multiRowSql(INSERT_ACTORS, 1, ";"));
+    insertLink = std::make_unique<SQLite::Statement>(db, multiRowSql(INSERT_LINKS, 1, LINKS_SUFFIX));
+}
+
+MovieWriter::~MovieWriter() {
+    commit();
+
+    // The statements have to be finalized before the journal mode can change
+    insertMovies.reset();
+    insertActors.reset();
+    insertLinks.reset();
+    insertMovie.reset();
+    insertActor.reset();
+    insertLink.reset();
+
+    // Fold the log back into the database file, so the year database is a single file again
+    try {
+        db.exec("PRAGMA wal_checkpoint(TRUNCATE);");
+        db.exec("PRAGMA journal_mode=DELETE;");
+        db.exec("PRAGMA synchronous=FULL;");
+    }
+    catch (const std::exception& e) {
+        std::cerr << std::format("Could not switch the database back from WAL mode: {} \n", e.what());
+    }
+}
+
+//=====================================================================================
+//                          Writing
+//=====================================================================================
+
+void MovieWriter::add(const MovieRecord& movie) {
+    if (!inTransaction) {
+        db.exec("BEGIN TRANSACTION;");
+        inTransaction = true;
+        commitDeadline = std::chrono::steady_clock::now() + maxCommitDelay;
+    }
+
+    pendingMovies.emplace_back(movie.movieID, movie.title);
+    for (const auto& [actorID, actorName] : movie.cast) {
+        pendingActors.emplace_back(actorID, actorName);
+        pendingLinks.emplace_back(movie.movieID, actorID);
+    }
+    transactionMovies++;
+    transactionCredits += movie.cast.size();
+    transactionRows += 1 + 2 * movie.cast.size();
+
+    insertFullChunks();
+    if (transactionMovies >= moviesPerCommit || std::chrono::steady_clock::now() >= commitDeadline) {
+        commit();
+    }
+}
+
+void MovieWriter::commitIfDue() {
+    if (inTransaction && std::chrono::steady_clock::now() >= commitDeadline) {
+        commit();
+    }
+}
+
+bool MovieWriter::commit() {
+    if (!inTransaction) {
+        return true;
+    }
+
+    auto startTime = std::chrono::steady_clock::now();
+    try {
+        // Whatever didn't fill a whole chunk goes in a row at a time
+        insertFullChunks();
+        for (size_t row = 0; row < pendingMovies.size(); row++) {
+            insertChunk(*insertMovie, pendingMovies, row);
+        }
+        for (size_t row = 0; row < pendingActors.size(); row++) {
+            insertChunk(*insertActor, pendingActors, row);
+        }
+        for (size_t row = 0; row < pendingLinks.size(); row++) {
+            insertChunk(*insertLink, pendingLinks, row);
+        }
+        pendingMovies.clear();
+        pendingActors.clear();
+        pendingLinks.clear();
+
+        db.exec("COMMIT;");
+    }
+    catch (const std::exception& e) {
+        rollback(e);
+        return false;
+    }
+    writeSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+    inTransaction = false;
+    moviesWritten += transactionMovies;
+    creditsWritten += transactionCredits;
+    rowsWritten += transactionRows;
+    commitCount++;
+    transactionMovies = 0;
+    transactionCredits = 0;
+    transactionRows = 0;
+    return true;
+}
+
+void MovieWriter::insertFullChunks() {
+    if (!inTransaction) {
+        return;
+    }
+
+    auto startTime = std::chrono::steady_clock::now();
+    try {
+        auto insertChunks = [&](SQLite::Statement& statement, auto& rows) {
+            size_t begin = 0;
+            for (; begin + ROWS_PER_INSERT <= rows.size(); begin += ROWS_PER_INSERT) {
+                insertChunk(statement, rows, begin);
+            }
+            rows.erase(rows.begin(), rows.begin() + begin);
+        };
+        insertChunks(*insertMovies, pendingMovies);
+        insertChunks(*insertActors, pendingActors);
+        insertChunks(*insertLinks, pendingLinks);
+    }
+    catch (const std::exception& e) {
+        rollback(e);
+        return;
+    }
+    writeSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+}
+
+// The single-row statements use these too, binding just the one row at begin
+void MovieWriter::insertChunk(SQLite::Statement& statement, const std::vector<std::pair<int, std::string>>& rows, size_t begin) {
+    int values = statement.getBindParameterCount();
+    for (int value = 0; value < values; value += 2) {
+        const auto& [id, text] = rows[begin + value / 2];
+        statement.bind(value + 1, id);
+        statement.bindNoCopy(value + 2, text); // The rows outlive the exec below
+    }
+    statement.exec();
+    statement.reset();
+}
+
+void MovieWriter::insertChunk(SQLite::Statement& statement, const std::vector<std::pair<int, int>>& rows, size_t begin) {
+    int values = statement.getBindParameterCount();
+    for (int value = 0; value < values; value += 2) {
+        statement.bind(value + 1, rows[begin + value / 2].first);
+        statement.bind(value + 2, rows[begin + value / 2].second);
+    }
+    statement.exec();
+    statement.reset();
+}
+
+void MovieWriter::rollback(const std::exception& e) {
+    std::cerr << std::format("Database Transaction Failed ({} movies lost): {} \n", transactionMovies, e.what());
+    try {
+        db.exec("ROLLBACK;"); //Cancels Transaction
+    }
+    catch (const std::exception&) {
+        // SQLite may have rolled back on its own already
+    }
+    insertMovies->reset();
+    insertActors->reset();
+    insertLinks->reset();
+    insertMovie->reset();
+    insertActor->reset();
+    insertLink->reset();
+    pendingMovies.clear();
+    pendingActors.clear();
+    pendingLinks.clear();
+    inTransaction = false;
+    transactionMovies = 0;
+    transactionCredits = 0;
+    transactionRows = 0;
+    failedCommits++;
+}
+
+//=====================================================================================
+//                          Accessors
+//=====================================================================================
+
+bool MovieWriter::hasPending() const {
+    return inTransaction;
+}
+
+std::chrono::steady_clock::time_point MovieWriter::getCommitDeadline() const {
+    return commitDeadline;
+}
+
+size_t MovieWriter::getMoviesWritten() const {
+    return moviesWritten;
+}
+
+size_t MovieWriter::getCreditsWritten() const {
+    return creditsWritten;
+}
+
+size_t MovieWriter::getRowsWritten() const {
+    return rowsWritten;
+}
+
+size_t MovieWriter::getCommitCount() const {
+    return commitCount;
+}
+
+void MovieWriter::printStatistics() const {
+    std::cout << std::format("Saved {} movies and {} cast links ({} rows) in {} transactions, {:.1f} s in SQLite, {:.0f} rows/s{}\n",
+        moviesWritten, creditsWritten, rowsWritten, commitCount, writeSeconds,
+        writeSeconds > 0.0 ? rowsWritten / writeSeconds : 0.0,
+        failedCommits > 0 ? std::format(", {} transactions failed", failedCommits) : std::string());
+}
@@ -0,0 +1,112 @@
+#ifndef MOVIEWRITER_H
+#define MOVIEWRITER_H
+
+#include <SQLiteCpp/SQLiteCpp.h>
+#include <string>
+#include <vector>
+#include <utility>
+#include <chrono>
+#include <memory>
+#include <cstddef>
+
+//=====================================================================================
+//                              Movie Record Structure
+//=====================================================================================
+// A movie and its cast, as parsed from TMDB and waiting to be saved
+struct MovieRecord {
+    int movieID;
+    std::string title;
+    std::vector<std::pair<int, std::string>> cast; // pair is <actorID, name>
+};
+
+//=====================================================================================
+//                              MovieWriter Class
+//=====================================================================================
+// Saves movies into a year database for the length of a collection run
+// Every statement is prepared once, rows are buffered and inserted ROWS_PER_INSERT at a time
+// with multi-row INSERTs, and a transaction stays open until moviesPerCommit movies are in it
+// or the first of them has waited maxCommitDelay. While it is open the database runs in WAL
+// mode with synchronous=NORMAL and a bigger page cache, and the destructor commits what's
+// left and puts the file back in its normal journal mode, so it can be copied or pushed alone.
+// Use a writer from one thread at a time.
+class MovieWriter {
+public:
+    // Rows per multi-row INSERT, 2 bound values each (well under SQLite's 32766 limit)
+    static constexpr size_t ROWS_PER_INSERT = 256;
+
+    // Page cache while collecting, in KiB (the pragma takes a negative size for KiB)
+    static constexpr int CACHE_SIZE_KIB = 65536;
+
+    MovieWriter(SQLite::Database& db, size_t moviesPerCommit = 500,
+        std::chrono::milliseconds maxCommitDelay = std::chrono::milliseconds(2000));
+    ~MovieWriter();
+
+    MovieWriter(const MovieWriter&) = delete;
+    MovieWriter& operator=(const MovieWriter&) = delete;
+
+    // Queue a movie and its cast, committing if that fills the transaction or it is overdue
+    void add(const MovieRecord& movie);
+
+    // Commit the open transaction if its first movie has waited maxCommitDelay
+    void commitIfDue();
+
+    // Insert everything buffered and commit, returns false if the transaction had to be rolled back
+    bool commit();
+
+    // Whether movies are waiting for a commit, and when the open transaction is due
+    bool hasPending() const;
+    std::chrono::steady_clock::time_point getCommitDeadline() const;
+
+    // Totals of what has been committed
+    size_t getMoviesWritten() const;
+    size_t getCreditsWritten() const;   // Cast links
+    size_t getRowsWritten() const;      // Movies, actors and cast links together
+    size_t getCommitCount() const;
+
+    // Rows per second, over the time spent inserting and committing
+    void printStatistics() const;
+
+private:
+    SQLite::Database& db;
+    size_t moviesPerCommit;
+    std::chrono::milliseconds maxCommitDelay;
+
+    // Full size multi-row statements, and single-row ones for what's left over at a commit
+    std::unique_ptr<SQLite::Statement> insertMovies;
+    std::unique_ptr<SQLite::Statement> insertActors;
+    std::unique_ptr<SQLite::Statement> insertLinks;
+    std::unique_ptr<SQLite::Statement> insertMovie;
+    std::unique_ptr<SQLite::Statement> insertActor;
+    std::unique_ptr<SQLite::Statement> insertLink;
+
+    // Rows not inserted yet
+    std::vector<std::pair<int, std::string>> pendingMovies;
+    std::vector<std::pair<int, std::string>> pendingActors;
+    std::vector<std::pair<int, int>> pendingLinks;
+
+    // The open transaction: whether there is one, when it is due, and what's in it so far
+    bool inTransaction;
+    std::chrono::steady_clock::time_point commitDeadline;
+    size_t transactionMovies;
+    size_t transactionCredits;
+    size_t transactionRows;
+
+    size_t moviesWritten;
+    size_t creditsWritten;
+    size_t rowsWritten;
+    size_t commitCount;
+    size_t failedCommits;
+    double writeSeconds; // Time spent inside SQLite
+
+    // Run ROWS_PER_INSERT buffered rows through a multi-row statement
+    void insertChunk(SQLite::Statement& statement, const std::vector<std::pair<int, std::string>>& rows, size_t begin);
+    void insertChunk(SQLite::Statement& statement, const std::vector<std::pair<int, int>>& rows, size_t begin);
+
+    // Insert every full chunk waiting in the buffers
+    void insertFullChunks();
+
+    // Give up on the open transaction after a failed insert or commit
+    void rollback(const std::exception& e);
+};
+
+#endif // MOVIEWRITER_H
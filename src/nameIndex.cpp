@@ -0,0 +1,203 @@
+#include "nameIndex.h"
+#include "graph.h"
+#include <algorithm>
+#include <tuple>
+#include <span>
+#include <cctype>
+#include <iterator>
+
+//=====================================================================================
+//                              Index Building
+//=====================================================================================
+
+NameIndex::NameIndex(const Graph& graph) {
+    int actorCount = static_cast<int>(graph.getActorCount());
+
+    // Step 1: Normalize every name once, and hash the full names for exact lookups
+    normalizedOffsets.reserve(actorCount + 1);
+    normalizedOffsets.push_back(0);
+    for (int i = 0; i < actorCount; i++) {
+        std::string_view name = graph.getName(i);
+        for (char c : name) {
+            normalized.push_back(static_cast<char>(std::tolower(static_cast<unsigned char>(c))));
+        }
+        normalizedOffsets.push_back(normalized.size());
+    }
+
+    exactNames.reserve(actorCount);
+    for (int i = 0; i < actorCount; i++) {
+        // Keeps the lowest ID on duplicates, which isn't the lowest index once the graph is reordered
+        auto [it, inserted] = exactNames.emplace(getNormalized(i), i);
+        if (!inserted && graph.getActorId(i) < graph.getActorId(it->second)) {
+            it->second = i;
+        }
+    }
+
+    // Step 2: Count how many names contain each trigram (once per name)
+    std::vector<std::uint32_t> nameTrigrams;
+    std::vector<std::uint64_t> counts;
+
+    auto collectTrigrams = [&](int index) {
+        std::string_view name = getNormalized(index);
+        nameTrigrams.clear();
+        for (size_t k = 0; k + 3 <= name.size(); k++) {
+            nameTrigrams.push_back(trigramKey(name.data() + k));
+        }
+        std::sort(nameTrigrams.begin(), nameTrigrams.end());
+        nameTrigrams.erase(std::unique(nameTrigrams.begin(), nameTrigrams.end()), nameTrigrams.end());
+    };
+
+    for (int i = 0; i < actorCount; i++) {
+        collectTrigrams(i);
+        for (std::uint32_t key : nameTrigrams) {
+            auto [it, inserted] = trigramSlots.try_emplace(key, static_cast<std::uint32_t>(counts.size()));
+            if (inserted) {
+                counts.push_back(0);
+            }
+            counts[it->second]++;
+        }
+    }
+
+    // Step 3: Fill the posting lists, walking indices in order keeps every list sorted
+    postingOffsets.assign(counts.size() + 1, 0);
+    for (size_t slot = 0; slot < counts.size(); slot++) {
+        postingOffsets[slot + 1] = postingOffsets[slot] + counts[slot];
+    }
+
+    postings.resize(postingOffsets.back());
+    std::vector<std::uint64_t> cursor(postingOffsets.begin(), postingOffsets.end() - 1);
+    for (int i = 0; i < actorCount; i++) {
+        collectTrigrams(i);
+        for (std::uint32_t key : nameTrigrams) {
+            postings[cursor[trigramSlots[key]]++] = i;
+        }
+    }
+}
+
+//=====================================================================================
+//                              Query Methods
+//=====================================================================================
+
+int NameIndex::findExact(std::string_view name) const {
+    std::string key = normalize(name);
+    auto it = exactNames.find(key);
+    if (it != exactNames.end()) {
+        return it->second;
+    }
+    return -1;
+}
+
+std::vector<int> NameIndex::findSubstring(std::string_view query, size_t maxResults) const {
+    std::string lowerQuery = normalize(query);
+    std::vector<int> candidates;
+
+    if (lowerQuery.size() < 3) {
+        // Too short for a trigram, scan the normalized names (no allocations per name)
+        for (size_t i = 0; i + 1 < normalizedOffsets.size(); i++) {
+            if (getNormalized(static_cast<int>(i)).find(lowerQuery) != std::string_view::npos) {
+                candidates.push_back(static_cast<int>(i));
+            }
+        }
+    }
+    else {
+        // Gather the posting list of every distinct trigram in the query, any missing trigram means no match
+        std::vector<std::uint32_t> queryTrigrams;
+        for (size_t k = 0; k + 3 <= lowerQuery.size(); k++) {
+            queryTrigrams.push_back(trigramKey(lowerQuery.data() + k));
+        }
+        std::sort(queryTrigrams.begin(), queryTrigrams.end());
+        queryTrigrams.erase(std::unique(queryTrigrams.begin(), queryTrigrams.end()), queryTrigrams.end());
+
+        std::vector<std::span<const int>> lists;
+        for (std::uint32_t key : queryTrigrams) {
+            auto it = trigramSlots.find(key);
+            if (it == trigramSlots.end()) {
+                return {};
+            }
+            std::uint64_t begin = postingOffsets[it->second];
+            std::uint64_t end = postingOffsets[it->second + 1];
+            lists.push_back(std::span<const int>(postings.data() + begin, end - begin));
+        }
+
+        // Intersect from the shortest list, so the work is bounded by the rarest trigram
+        std::sort(lists.begin(), lists.end(),
+            [](const auto& a, const auto& b) { return a.size() < b.size(); });
+
+        candidates.assign(lists[0].begin(), lists[0].end());
+        std::vector<int> next;
+        for (size_t l = 1; l < lists.size() && !candidates.empty(); l++) {
+            next.clear();
+            std::set_intersection(candidates.begin(), candidates.end(),
+                lists[l].begin(), lists[l].end(), std::back_inserter(next));
+            candidates.swap(next);
+        }
+
+        // Having every trigram doesn't guarantee they appear in order, so verify what's left
+        std::erase_if(candidates, [&](int index) {
+            return getNormalized(index).find(lowerQuery) == std::string_view::npos;
+        });
+    }
+
+    // Rank the matches, then trim to the requested count
+    std::vector<std::tuple<int, size_t, int>> ranked;
+    ranked.reserve(candidates.size());
+    for (int index : candidates) {
+        std::string_view name = getNormalized(index);
+        ranked.emplace_back(matchRank(name, lowerQuery), name.size(), index);
+    }
+
+    if (maxResults > 0 && maxResults < ranked.size()) {
+        std::partial_sort(ranked.begin(), ranked.begin() + maxResults, ranked.end());
+        ranked.resize(maxResults);
+    }
+    else {
+        std::sort(ranked.begin(), ranked.end());
+    }
+
+    std::vector<int> results;
+    results.reserve(ranked.size());
+    for (const auto& entry : ranked) {
+        results.push_back(std::get<2>(entry));
+    }
+    return results;
+}
+
+//=====================================================================================
+//                              Helper Methods
+//=====================================================================================
+
+std::string NameIndex::normalize(std::string_view name) {
+    std::string lower(name);
+    for (char& c : lower) {
+        c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+    return lower;
+}
+
+std::string_view NameIndex::getNormalized(int index) const {
+    return std::string_view(normalized.data() + normalizedOffsets[index],
+        normalizedOffsets[index + 1] - normalizedOffsets[index]);
+}
+
+int NameIndex::matchRank(std::string_view name, std::string_view query) {
+    if (name == query) {
+        return 0;
+    }
+    if (name.starts_with(query)) {
+        return 1;
+    }
+    size_t position = name.find(query);
+    while (position != std::string_view::npos) {
+        if (position > 0 && name[position - 1] == ' ') {
+            return 2;
+        }
+        position = name.find(query, position + 1);
+    }
+    return 3;
+}
+
+std::uint32_t NameIndex::trigramKey(const char* text) {
+    return (static_cast<std::uint32_t>(static_cast<unsigned char>(text[0])) << 16) |
+        (static_cast<std::uint32_t>(static_cast<unsigned char>(text[1])) << 8) |
+        static_cast<std::uint32_t>(static_cast<unsigned char>(text[2]));
+}
@@ -0,0 +1,60 @@
+#ifndef NAMEINDEX_H
+#define NAMEINDEX_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+
+class Graph;
+
+//=====================================================================================
+//                              NameIndex Class
+//=====================================================================================
+// Prebuilt index over the actor names of a graph, used for the name lookups
+// Every name is lowercased once and stored packed, then indexed two ways:
+//   - A hash of the full normalized name, for exact (case-insensitive) lookups
+//   - Trigram posting lists (sorted dense indices), for substring searches
+// A substring query intersects the posting lists of its trigrams, starting from the
+// shortest, and only verifies the few names left, instead of scanning every actor.
+class NameIndex {
+public:
+    // Build the index for every actor currently in the graph
+    explicit NameIndex(const Graph& graph);
+
+    // Dense index of the actor with exactly this name (ignoring case), -1 if none
+    // If several actors share a name, the one with the lowest ID is returned
+    int findExact(std::string_view name) const;
+
+    // Dense indices of actors whose name contains the query (ignoring case), best matches first
+    // Ranking: exact match, then prefix, then start of a word, then anywhere; shorter names first
+    // maxResults of 0 returns every match
+    std::vector<int> findSubstring(std::string_view query, size_t maxResults = 0) const;
+
+    // Lowercase a name the same way the index does
+    static std::string normalize(std::string_view name);
+
+private:
+    // Normalized names, name of index i is normalized[normalizedOffsets[i] .. normalizedOffsets[i + 1])
+    std::vector<char> normalized;
+    std::vector<std::uint64_t> normalizedOffsets;
+
+    // Normalized name -> dense index of the lowest actor ID with that name
+    std::unordered_map<std::string_view, int> exactNames;
+
+    // Trigram -> slot, the postings of a slot are postings[postingOffsets[slot] .. postingOffsets[slot + 1])
+    std::unordered_map<std::uint32_t, std::uint32_t> trigramSlots;
+    std::vector<std::uint64_t> postingOffsets;
+    std::vector<int> postings;
+
+    std::string_view getNormalized(int index) const;
+
+    // Relevance of a match (lower is better)
+    static int matchRank(std::string_view name, std::string_view query);
+
+    // Pack three bytes into one trigram key
+    static std::uint32_t trigramKey(const char* text);
+};
+
+#endif // NAMEINDEX_H
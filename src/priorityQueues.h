@@ -0,0 +1,244 @@
+#ifndef PRIORITYQUEUES_H
+#define PRIORITYQUEUES_H
+
+#include <vector>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <bit>
+
+//=====================================================================================
+//                          Dijkstra Priority Queues
+//=====================================================================================
+// Interchangeable min-queues of (key, dense index) for Dijkstra, all with the same interface:
+//   clear()            forget every entry (capacity is kept)
+//   empty()
+//   push(key, index)   add index with this key, or lower its key if it's already queued
+//   top()              the entry with the smallest key, without removing it
+//   pop()              remove and return the entry with the smallest key
+// The lazy queues just add another entry on push, so an index can come out more than
+// once, and the caller skips the stale copies (Dijkstra already skips settled actors).
+
+//=====================================================================================
+//                          LazyBinaryHeap Class
+//=====================================================================================
+// std::push_heap/pop_heap over a vector, the original Dijkstra queue
+// Cheap per operation, but stale entries pile up around hubs
+template <typename Key>
+class LazyBinaryHeap {
+public:
+    void clear() {
+        entries.clear();
+    }
+
+    bool empty() const {
+        return entries.empty();
+    }
+
+    void push(Key key, int index) {
+        entries.emplace_back(key, index);
+        std::push_heap(entries.begin(), entries.end(), order);
+    }
+
+    const std::pair<Key, int>& top() const {
+        return entries.front();
+    }
+
+    std::pair<Key, int> pop() {
+        std::pop_heap(entries.begin(), entries.end(), order);
+        std::pair<Key, int> smallest = entries.back();
+        entries.pop_back();
+        return smallest;
+    }
+
+private:
+    // Ordered by key only (min-heap), same as the old priority_queue
+    static bool order(const std::pair<Key, int>& a, const std::pair<Key, int>& b) {
+        return a.first > b.first;
+    }
+
+    std::vector<std::pair<Key, int>> entries;
+};
+
+//=====================================================================================
+//                          IndexedDaryHeap Class
+//=====================================================================================
+// D-ary heap with decrease-key: every index is queued at most once, and position[] tracks
+// where it sits so a better key moves it up in place. No stale entries, and with D = 4 the
+// heap is shallower and each sift touches fewer cache lines than a binary heap.
+template <typename Key, int D = 4>
+class IndexedDaryHeap {
+public:
+    // Make room for indices below count (positions start out as "not queued")
+    void reserveIndices(size_t count) {
+        if (position.size() < count) {
+            position.resize(count, -1);
+        }
+    }
+
+    // Only resets the positions of indices still queued, so it never walks the whole graph
+    void clear() {
+        for (const auto& entry : entries) {
+            position[entry.second] = -1;
+        }
+        entries.clear();
+    }
+
+    bool empty() const {
+        return entries.empty();
+    }
+
+    void push(Key key, int index) {
+        int slot = position[index];
+        if (slot == -1) {
+            slot = static_cast<int>(entries.size());
+            entries.emplace_back(key, index);
+        }
+        else if (key < entries[slot].first) {
+            entries[slot].first = key;
+        }
+        else {
+            return;
+        }
+        siftUp(slot);
+    }
+
+    const std::pair<Key, int>& top() const {
+        return entries.front();
+    }
+
+    std::pair<Key, int> pop() {
+        std::pair<Key, int> smallest = entries.front();
+        position[smallest.second] = -1;
+
+        std::pair<Key, int> last = entries.back();
+        entries.pop_back();
+        if (!entries.empty()) {
+            entries.front() = last;
+            siftDown(0);
+        }
+        return smallest;
+    }
+
+private:
+    void siftUp(int slot) {
+        std::pair<Key, int> moving = entries[slot];
+        while (slot > 0) {
+            int parentSlot = (slot - 1) / D;
+            if (!(moving.first < entries[parentSlot].first)) {
+                break;
+            }
+            place(slot, entries[parentSlot]);
+            slot = parentSlot;
+        }
+        place(slot, moving);
+    }
+
+    void siftDown(int slot) {
+        std::pair<Key, int> moving = entries[slot];
+        int size = static_cast<int>(entries.size());
+        while (true) {
+            int firstChild = slot * D + 1;
+            if (firstChild >= size) {
+                break;
+            }
+
+            // Smallest of up to D children
+            int best = firstChild;
+            int lastChild = std::min(firstChild + D, size);
+            for (int child = firstChild + 1; child < lastChild; child++) {
+                if (entries[child].first < entries[best].first) {
+                    best = child;
+                }
+            }
+
+            if (!(entries[best].first < moving.first)) {
+                break;
+            }
+            place(slot, entries[best]);
+            slot = best;
+        }
+        place(slot, moving);
+    }
+
+    void place(int slot, const std::pair<Key, int>& entry) {
+        entries[slot] = entry;
+        position[entry.second] = slot;
+    }
+
+    std::vector<std::pair<Key, int>> entries;
+    std::vector<int> position;  // Slot of each queued index, -1 if not queued
+};
+
+//=====================================================================================
+//                          RadixHeap Class
+//=====================================================================================
+// Monotone integer queue: keys pushed must never be smaller than the last key popped,
+// which always holds in Dijkstra (costs only grow). Entries go into bucket b when their
+// key first differs from the last popped key at bit b-1, so an entry only ever moves to
+// lower buckets, at most 64 times in total, and a pop is a scan of 65 buckets at worst.
+// Lazy like the binary heap, push doesn't remove older entries of the same index.
+class RadixHeap {
+public:
+    RadixHeap() : lastKey(0), entryCount(0) {}
+
+    void clear() {
+        for (auto& bucket : buckets) {
+            bucket.clear();
+        }
+        lastKey = 0;
+        entryCount = 0;
+    }
+
+    bool empty() const {
+        return entryCount == 0;
+    }
+
+    void push(std::uint64_t key, int index) {
+        buckets[bucketFor(key)].emplace_back(key, index);
+        entryCount++;
+    }
+
+    // Not const, finding the smallest entry may move entries down into bucket 0
+    const std::pair<std::uint64_t, int>& top() {
+        if (buckets[0].empty()) {
+            // Find the first non-empty bucket, its smallest key becomes the new lastKey
+            int b = 1;
+            while (buckets[b].empty()) {
+                b++;
+            }
+
+            std::uint64_t smallest = buckets[b][0].first;
+            for (const auto& entry : buckets[b]) {
+                smallest = std::min(smallest, entry.first);
+            }
+            lastKey = smallest;
+
+            // Every entry of that bucket now lands in a lower one (the smallest in bucket 0)
+            for (const auto& entry : buckets[b]) {
+                buckets[bucketFor(entry.first)].push_back(entry);
+            }
+            buckets[b].clear();
+        }
+        return buckets[0].back();
+    }
+
+    std::pair<std::uint64_t, int> pop() {
+        std::pair<std::uint64_t, int> smallest = top();
+        buckets[0].pop_back();
+        entryCount--;
+        return smallest;
+    }
+
+private:
+    int bucketFor(std::uint64_t key) const {
+        return key == lastKey ? 0 : 64 - std::countl_zero(key ^ lastKey);
+    }
+
+    std::vector<std::pair<std::uint64_t, int>> buckets[65];
+    std::uint64_t lastKey;
+    size_t entryCount;
+};
+
+#endif // PRIORITYQUEUES_H
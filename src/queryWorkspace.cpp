@@ -0,0 +1,51 @@
+#include "queryWorkspace.h"
+#include <algorithm>
+
+// Largest epoch that still fits in the upper 7 bits of a stamp
+constexpr std::uint32_t MAX_EPOCH = 127;
+
+//=====================================================================================
+//                          Constructor & Thread Workspaces
+//=====================================================================================
+
+QueryWorkspace::QueryWorkspace() : epoch(0) {
+}
+
+QueryWorkspace& QueryWorkspace::forThread(int slot) {
+    thread_local QueryWorkspace workspaces[SLOTS_PER_THREAD];
+    return workspaces[slot];
+}
+
+//=====================================================================================
+//                              Query Reset
+//=====================================================================================
+
+void QueryWorkspace::beginQuery(size_t actorCount) {
+    // Only grows when the graph is bigger than anything seen before (new stamps start at 0)
+    if (stamp.size() < actorCount) {
+        stamp.resize(actorCount, 0);
+        parent.resize(actorCount, -1);
+        hops.resize(actorCount, -1);
+        cost.resize(actorCount, 0.0);
+        costUnits.resize(actorCount, 0);
+        daryHeap.reserveIndices(actorCount);
+    }
+    if (visitedBits.size() != actorCount) {
+        visitedBits.assign(actorCount);
+        frontierBits.assign(actorCount);
+        nextBits.assign(actorCount);
+    }
+
+    // Epochs run 1..127 (0 is what fresh stamps hold), then the stamps need one real clear
+    if (epoch == MAX_EPOCH) {
+        std::fill(stamp.begin(), stamp.end(), 0);
+        epoch = 0;
+    }
+    epoch++;
+
+    queue.clear();
+    nextFrontier.clear();
+    binaryHeap.clear();
+    daryHeap.clear();
+    radixHeap.clear();
+}
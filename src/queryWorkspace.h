@@ -0,0 +1,108 @@
+#ifndef QUERYWORKSPACE_H
+#define QUERYWORKSPACE_H
+
+#include <vector>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+#include "bitmap.h"
+#include "priorityQueues.h"
+
+//=====================================================================================
+//                              QueryWorkspace Class
+//=====================================================================================
+// Scratch memory for one search, reused across queries instead of allocating fresh
+// hash maps every time. All arrays are indexed by dense graph index.
+//
+// Resetting is O(1): every query bumps the epoch, and an actor only counts as reached
+// (or settled) if its stamp matches the current epoch, so nothing has to be cleared.
+// Stamps are a single byte per actor (the same footprint as a plain visited array),
+// so the epoch wraps every 127 queries, and only then is the stamp array really cleared.
+// parent/hops/cost are only meaningful for actors reached in the current query.
+//
+// Each thread gets its own workspaces through forThread(), so searches on different
+// threads never share one. Once the arrays have grown to the graph's size, queries
+// don't allocate at all (apart from building the PathResult itself).
+class QueryWorkspace {
+public:
+    QueryWorkspace();
+
+    // Workspaces can be large, so they're never copied by accident
+    QueryWorkspace(const QueryWorkspace&) = delete;
+    QueryWorkspace& operator=(const QueryWorkspace&) = delete;
+
+    // The calling thread's workspace, slot lets one query use several (e.g. one per search direction)
+    static QueryWorkspace& forThread(int slot = 0);
+
+    // Number of workspace slots available per thread
+    static constexpr int SLOTS_PER_THREAD = 2;
+
+    // Start a new query over actorCount actors, forgetting the previous one in O(1)
+    void beginQuery(size_t actorCount);
+
+    //=====================================================================================
+    //                          Per-Actor State
+    //=====================================================================================
+
+    // Handle to the stamps of the current query. It's a plain pointer and epoch, so a search
+    // copies it into a local before its main loop and the compiler keeps both in registers
+    // (going through the workspace made it reload them for every edge).
+    struct Stamps {
+        std::uint8_t* stamp;
+        std::uint32_t epoch;
+
+        // Reached: the actor has a tentative parent/hops/cost this query
+        bool isReached(int index) const {
+            return (stamp[index] >> 1) == epoch;
+        }
+
+        // Must not be called on an actor that is already settled
+        void markReached(int index) {
+            stamp[index] = static_cast<std::uint8_t>(epoch << 1);
+        }
+
+        // Settled: the actor's values are final (also counts as reached)
+        bool isSettled(int index) const {
+            return stamp[index] == ((epoch << 1) | 1);
+        }
+
+        void markSettled(int index) {
+            stamp[index] = static_cast<std::uint8_t>((epoch << 1) | 1);
+        }
+    };
+
+    // Only valid until the next beginQuery()
+    Stamps stamps() {
+        return Stamps{ stamp.data(), epoch };
+    }
+
+    std::vector<int> parent;                // Previous actor on the best known path
+    std::vector<int> hops;                  // Hop distance from the source
+    std::vector<double> cost;               // Weighted distance from the source
+    std::vector<std::uint64_t> costUnits;   // Same, in the integer units used by the radix heap
+
+    //=====================================================================================
+    //                          Preallocated Containers
+    //=====================================================================================
+    // Cleared by beginQuery(), capacity is kept between queries
+
+    std::vector<int> queue;                     // BFS queue / current frontier
+    std::vector<int> nextFrontier;              // Next BFS level
+
+    // Dijkstra queues of (cost, index), one per queue type
+    LazyBinaryHeap<double> binaryHeap;
+    IndexedDaryHeap<double> daryHeap;
+    RadixHeap radixHeap;
+
+    // Bitmaps for the direction-optimizing BFS (sized by beginQuery, cleared by the search)
+    Bitmap visitedBits;
+    Bitmap frontierBits;
+    Bitmap nextBits;
+
+private:
+    // Epoch in the upper 7 bits, settled flag in the lowest bit
+    std::vector<std::uint8_t> stamp;
+    std::uint32_t epoch;
+};
+
+#endif // QUERYWORKSPACE_H
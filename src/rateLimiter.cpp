@@ -0,0 +1,138 @@
+#include "rateLimiter.h"
+#include <iostream>
+#include <format>
+#include <algorithm>
+#include <thread>
+
+//=====================================================================================
+//                          Constructor
+//=====================================================================================
+
+RateLimiter::RateLimiter(double requestsPerSecond)
+    : maxRate(std::max(MIN_RATE, requestsPerSecond)), rate(maxRate), tokens(1.0),
+    lastRefill(Clock::now()), pausedUntil(lastRefill), consecutiveRateLimits(0), successesSinceChange(0),
+    requestCount(0), rateLimitedCount(0), random(std::random_device{}()),
+    windowStart(lastRefill), windowRequests(0) {
+}
+
+//=====================================================================================
+//                          Token Methods
+//=====================================================================================
+
+std::chrono::milliseconds RateLimiter::tryAcquire() {
+    std::lock_guard<std::mutex> lock(mutex);
+    Clock::time_point now = Clock::now();
+
+    if (now < pausedUntil) {
+        return std::chrono::ceil<std::chrono::milliseconds>(pausedUntil - now);
+    }
+
+    refill(now);
+    if (tokens < 1.0) {
+        // Round up, so the caller never wakes a moment before the token is there
+        auto wait = std::chrono::duration<double>((1.0 - tokens) / rate);
+        return std::max(std::chrono::milliseconds(1), std::chrono::ceil<std::chrono::milliseconds>(wait));
+    }
+
+    tokens -= 1.0;
+    requestCount++;
+    windowRequests++;
+
+    if (now - windowStart >= LOG_INTERVAL) {
+        double seconds = std::chrono::duration<double>(now - windowStart).count();
+        std::cout << std::format("Rate limiter: {:.1f} requests/s (allowing {:.1f} of {:.1f}), {} rate limited so far\n",
+            windowRequests / seconds, rate, maxRate, rateLimitedCount);
+        windowStart = now;
+        windowRequests = 0;
+    }
+    return std::chrono::milliseconds(0);
+}
+
+void RateLimiter::acquire() {
+    for (auto wait = tryAcquire(); wait.count() > 0; wait = tryAcquire()) {
+        std::this_thread::sleep_for(wait);
+    }
+}
+
+void RateLimiter::refill(Clock::time_point now) {
+    if (now <= lastRefill) {
+        return; // Still paused, tokens only start coming back once the pause is over
+    }
+    double elapsed = std::chrono::duration<double>(now - lastRefill).count();
+    tokens = std::min(std::max(1.0, rate), tokens + elapsed * rate);
+    lastRefill = now;
+}
+
+//=====================================================================================
+//                          Feedback Methods
+//=====================================================================================
+
+void RateLimiter::onSuccess() {
+    std::lock_guard<std::mutex> lock(mutex);
+    consecutiveRateLimits = 0;
+
+    // Climb back a tenth of the budget at a time, once every second's worth of requests has gone through
+    if (rate < maxRate && ++successesSinceChange >= static_cast<size_t>(rate)) {
+        refill(Clock::now());
+        rate = std::min(maxRate, rate + maxRate / 10.0);
+        successesSinceChange = 0;
+    }
+}
+
+void RateLimiter::onRateLimited(long retryAfterSeconds) {
+    std::lock_guard<std::mutex> lock(mutex);
+    Clock::time_point now = Clock::now();
+    rateLimitedCount++;
+
+    // Requests already in flight when the limit hit all come back as 429s, so only the first one
+    // of a burst halves the rate and counts towards the backoff (the pause is still extended by every later one)
+    bool firstOfBurst = now >= pausedUntil;
+    if (firstOfBurst) {
+        refill(now);
+        rate = std::max(MIN_RATE, rate / 2.0);
+        successesSinceChange = 0;
+        consecutiveRateLimits++;
+    }
+
+    Clock::duration pause;
+    if (retryAfterSeconds > 0) {
+        pause = std::chrono::seconds(retryAfterSeconds);
+    }
+    else {
+        int doublings = std::min(consecutiveRateLimits - 1, 16);
+        std::chrono::milliseconds backoff = std::min(MAX_BACKOFF, BASE_BACKOFF * (1 << doublings));
+        std::uniform_int_distribution<long long> jitter(backoff.count() / 2, backoff.count());
+        pause = std::chrono::milliseconds(jitter(random));
+    }
+
+    pausedUntil = std::max(pausedUntil, now + pause);
+    tokens = 0.0;
+    lastRefill = pausedUntil;
+    if (firstOfBurst) {
+        std::cout << std::format("Rate limited by the server, pausing {} ms and slowing to {:.1f} requests/s\n",
+            std::chrono::duration_cast<std::chrono::milliseconds>(pausedUntil - now).count(), rate);
+    }
+}
+
+//=====================================================================================
+//                          Accessors
+//=====================================================================================
+
+double RateLimiter::getRate() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return rate;
+}
+
+double RateLimiter::getMaxRate() const {
+    return maxRate;
+}
+
+size_t RateLimiter::getRequestCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return requestCount;
+}
+
+size_t RateLimiter::getRateLimitedCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return rateLimitedCount;
+}
@@ -0,0 +1,75 @@
+#ifndef RATELIMITER_H
+#define RATELIMITER_H
+
+#include <chrono>
+#include <mutex>
+#include <random>
+#include <cstddef>
+
+//=====================================================================================
+//                              RateLimiter Class
+//=====================================================================================
+// Token bucket shared by everything that calls one API, safe to use from any number of threads
+// Tokens refill at the current rate (up to one second's worth), and every request takes one.
+// The rate adapts to the server: a 429 halves it and pauses every request for the server's
+// Retry-After, or an exponential backoff with jitter when it didn't send one. After a run of
+// successes the rate climbs back up towards the configured budget.
+class RateLimiter {
+public:
+    // Start at the full budget of requestsPerSecond
+    explicit RateLimiter(double requestsPerSecond);
+
+    // Take a token if one is ready, returning zero, or return how long until one will be
+    std::chrono::milliseconds tryAcquire();
+
+    // Take a token, sleeping until one is ready
+    void acquire();
+
+    // Report how a request went, so the rate can adapt
+    // retryAfterSeconds is the server's Retry-After header, 0 if it didn't send one
+    void onSuccess();
+    void onRateLimited(long retryAfterSeconds);
+
+    // The rate tokens refill at right now, and the most it will go back up to
+    double getRate() const;
+    double getMaxRate() const;
+
+    // Requests let through and rate limits reported since construction
+    size_t getRequestCount() const;
+    size_t getRateLimitedCount() const;
+
+    // Lowest rate a run of 429s can push it down to
+    static constexpr double MIN_RATE = 0.5;
+
+    // Backoff without a Retry-After: BASE_BACKOFF doubled for every 429 in a row, capped at MAX_BACKOFF,
+    // then a random point in its upper half so the clients that were turned away together don't return together
+    static constexpr std::chrono::milliseconds BASE_BACKOFF{ 250 };
+    static constexpr std::chrono::milliseconds MAX_BACKOFF{ 30000 };
+
+    // How often the effective request rate is printed while requests are going through
+    static constexpr std::chrono::seconds LOG_INTERVAL{ 10 };
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    mutable std::mutex mutex;
+    double maxRate;
+    double rate;
+    double tokens;
+    Clock::time_point lastRefill;
+    Clock::time_point pausedUntil;    // No tokens are handed out before this, after a 429
+    int consecutiveRateLimits;
+    size_t successesSinceChange;      // Successes since the rate last changed, it climbs after a second's worth
+    size_t requestCount;
+    size_t rateLimitedCount;
+    std::mt19937 random;
+
+    // Start of the current logging window, and the requests let through in it
+    Clock::time_point windowStart;
+    size_t windowRequests;
+
+    // Add the tokens earned since the last refill (caller holds the lock)
+    void refill(Clock::time_point now);
+};
+
+#endif // RATELIMITER_H
@@ -0,0 +1,310 @@
+#include "tmdbParser.h"
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+namespace {
+    //=====================================================================================
+    //                          SAX Handlers
+    //=====================================================================================
+    // nlohmann calls these as it reads the document. Each handler keeps a stack of the
+    // containers it is inside, marking only the ones on the path to a wanted value, and
+    // remembers which wanted key (if any) the next value belongs to. Returning false stops the parse.
+
+    // Callbacks every handler ignores, and the error report
+    class SkippingHandler : public nlohmann::json_sax<json> {
+    public:
+        bool binary(binary_t&) override { return skipValue(); }
+        bool number_float(number_float_t, const string_t&) override { return skipValue(); }
+
+        bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception& e) override {
+            error = e.what();
+            return false;
+        }
+
+        std::string error;
+        bool finished = false; // Stopped early because everything wanted had been read
+
+    protected:
+        virtual bool skipValue() = 0;
+    };
+
+    class MovieDetailsHandler final : public SkippingHandler {
+    public:
+        explicit MovieDetailsHandler(MovieDetails& details) : details(details) {}
+
+        bool start_object(std::size_t) override {
+            Scope scope = Scope::Other;
+            if (scopes.empty()) {
+                scope = Scope::Root;
+            }
+            else if (scopes.back() == Scope::Root && field == Field::Credits) {
+                scope = Scope::Credits;
+            }
+            else if (scopes.back() == Scope::Cast) {
+                scope = Scope::Actor;
+                actorID = -1;
+                actorName = "N/A";
+            }
+            scopes.push_back(scope);
+            field = Field::Other;
+            return true;
+        }
+
+        bool end_object() override {
+            if (scopes.back() == Scope::Actor && actorID != -1) {
+                details.cast.emplace_back(actorID, std::move(actorName));
+            }
+            scopes.pop_back();
+            field = Field::Other;
+            return true;
+        }
+
+        bool start_array(std::size_t) override {
+            bool isCast = !scopes.empty() && scopes.back() == Scope::Credits && field == Field::Cast;
+            scopes.push_back(isCast ? Scope::Cast : Scope::Other);
+            field = Field::Other;
+            return true;
+        }
+
+        bool end_array() override {
+            bool castDone = scopes.back() == Scope::Cast;
+            scopes.pop_back();
+            field = Field::Other;
+            // TMDB puts the title before credits, and the cast before the crew, so the rest can be skipped
+            if (castDone && titleSeen) {
+                finished = true;
+                return false;
+            }
+            return true;
+        }
+
+        bool key(string_t& name) override {
+            field = Field::Other;
+            switch (scopes.back()) {
+            case Scope::Root:
+                if (name == "title") field = Field::Title;
+                else if (name == "credits") field = Field::Credits;
+                else if (name == "status_code") field = Field::StatusCode;
+                break;
+            case Scope::Credits:
+                if (name == "cast") field = Field::Cast;
+                break;
+            case Scope::Actor:
+                if (name == "id") field = Field::Id;
+                else if (name == "name") field = Field::Name;
+                break;
+            default:
+                break;
+            }
+            return true;
+        }
+
+        bool string(string_t& value) override {
+            if (field == Field::Title) {
+                details.title = std::move(value);
+            }
+            else if (field == Field::Name) {
+                actorName = std::move(value);
+            }
+            return skipValue();
+        }
+
+        bool number_integer(number_integer_t value) override { return integer(value); }
+        bool number_unsigned(number_unsigned_t value) override { return integer(static_cast<number_integer_t>(value)); }
+        bool null() override { return skipValue(); }
+        bool boolean(bool) override { return skipValue(); }
+
+    private:
+        enum class Scope { Other, Root, Credits, Cast, Actor };
+        enum class Field { Other, Title, StatusCode, Credits, Cast, Id, Name };
+
+        MovieDetails& details;
+        std::vector<Scope> scopes;
+        Field field = Field::Other;
+        bool titleSeen = false;
+        int actorID = -1;
+        std::string actorName;
+
+        bool integer(number_integer_t value) {
+            if (field == Field::StatusCode) {
+                details.statusCode = static_cast<int>(value);
+            }
+            else if (field == Field::Id) {
+                actorID = static_cast<int>(value);
+            }
+            return skipValue();
+        }
+
+        // Every value lands here last, the key it belonged to is used up
+        bool skipValue() override {
+            if (field == Field::Title) {
+                titleSeen = true;
+            }
+            else if (field == Field::StatusCode && !details.statusCode) {
+                details.statusCode = 0;
+            }
+            field = Field::Other;
+            return true;
+        }
+    };
+
+    class DiscoverHandler final : public SkippingHandler {
+    public:
+        explicit DiscoverHandler(std::vector<int>& movieIDs) : movieIDs(movieIDs) {}
+
+        bool start_object(std::size_t) override {
+            Scope scope = Scope::Other;
+            if (scopes.empty()) {
+                scope = Scope::Root;
+            }
+            else if (scopes.back() == Scope::Results) {
+                scope = Scope::Result;
+            }
+            scopes.push_back(scope);
+            field = Field::Other;
+            return true;
+        }
+
+        bool end_object() override {
+            scopes.pop_back();
+            field = Field::Other;
+            return true;
+        }
+
+        bool start_array(std::size_t) override {
+            bool isResults = !scopes.empty() && scopes.back() == Scope::Root && field == Field::Results;
+            scopes.push_back(isResults ? Scope::Results : Scope::Other);
+            field = Field::Other;
+            return true;
+        }
+
+        bool end_array() override {
+            bool resultsDone = scopes.back() == Scope::Results;
+            scopes.pop_back();
+            field = Field::Other;
+            // Only the page counts come after the results
+            if (resultsDone) {
+                finished = true;
+                return false;
+            }
+            return true;
+        }
+
+        bool key(string_t& name) override {
+            field = Field::Other;
+            if (scopes.back() == Scope::Root && name == "results") {
+                field = Field::Results;
+            }
+            else if (scopes.back() == Scope::Result && name == "id") {
+                field = Field::Id;
+            }
+            return true;
+        }
+
+        bool number_integer(number_integer_t value) override { return integer(value); }
+        bool number_unsigned(number_unsigned_t value) override { return integer(static_cast<number_integer_t>(value)); }
+        bool string(string_t&) override { return skipValue(); }
+        bool null() override { return skipValue(); }
+        bool boolean(bool) override { return skipValue(); }
+
+    private:
+        enum class Scope { Other, Root, Results, Result };
+        enum class Field { Other, Results, Id };
+
+        std::vector<int>& movieIDs;
+        std::vector<Scope> scopes;
+        Field field = Field::Other;
+
+        bool integer(number_integer_t value) {
+            if (field == Field::Id) {
+                movieIDs.push_back(static_cast<int>(value));
+            }
+            return skipValue();
+        }
+
+        bool skipValue() override {
+            field = Field::Other;
+            return true;
+        }
+    };
+
+    // Runs a handler over body, true if it reached the end or stopped once it had everything
+    template <typename Handler>
+    bool runHandler(const std::string& body, Handler& handler, std::string& error) {
+        if (json::sax_parse(body, &handler) || handler.finished) {
+            return true;
+        }
+        error = handler.error.empty() ? "JSON ended early" : handler.error;
+        return false;
+    }
+}
+
+//=====================================================================================
+//                          Movie Details
+//=====================================================================================
+
+bool extractMovieDetails(const std::string& body, MovieDetails& details, std::string& error) {
+    details = MovieDetails();
+    details.title = "N/A";
+    MovieDetailsHandler handler(details);
+    return runHandler(body, handler, error);
+}
+
+bool extractMovieDetailsDom(const std::string& body, MovieDetails& details, std::string& error) {
+    details = MovieDetails();
+    try {
+        json movieData = json::parse(body);
+        if (movieData.contains("status_code")) {
+            details.statusCode = movieData["status_code"].is_number_integer() ? movieData["status_code"].get<int>() : 0;
+        }
+        details.title = movieData.contains("title") && movieData["title"].is_string() ? movieData["title"].get<std::string>() : "N/A";
+        json castArray = movieData.value("credits", json::object()).value("cast", json::array());
+        for (const auto& actor : castArray) {
+            int actorID = actor.contains("id") && actor["id"].is_number_integer() ? actor["id"].get<int>() : -1;
+            if (actorID != -1) {
+                details.cast.emplace_back(actorID, actor.contains("name") && actor["name"].is_string() ? actor["name"].get<std::string>() : "N/A");
+            }
+        }
+        return true;
+    }
+    catch (json::exception& e) {
+        error = e.what();
+        return false;
+    }
+}
+
+//=====================================================================================
+//                          Discover Pages
+//=====================================================================================
+
+bool extractDiscoverIds(const std::string& body, std::vector<int>& movieIDs, std::string& error) {
+    movieIDs.clear();
+    DiscoverHandler handler(movieIDs);
+    if (!runHandler(body, handler, error)) {
+        movieIDs.clear();
+        return false;
+    }
+    return true;
+}
+
+bool extractDiscoverIdsDom(const std::string& body, std::vector<int>& movieIDs, std::string& error) {
+    movieIDs.clear();
+    try {
+        json parsed = json::parse(body);
+        if (!parsed.contains("results")) {
+            return true;
+        }
+        for (const auto& movie : parsed["results"]) {
+            if (movie.contains("id") && movie["id"].is_number_integer()) {
+                movieIDs.push_back(movie["id"].get<int>());
+            }
+        }
+        return true;
+    }
+    catch (json::exception& e) {
+        error = e.what();
+        movieIDs.clear();
+        return false;
+    }
+}
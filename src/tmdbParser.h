@@ -0,0 +1,34 @@
+#ifndef TMDBPARSER_H
+#define TMDBPARSER_H
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <optional>
+
+//=====================================================================================
+//                              TMDB Response Extraction
+//=====================================================================================
+// Pulls the few fields collection needs out of TMDB responses without building a json DOM.
+// The extractors run nlohmann's SAX parser with a handler that only keeps the wanted values,
+// so nothing else (like the crew list, often most of a movie response) is ever allocated,
+// and they stop reading once everything they want has gone past.
+// The DOM versions do the same the old way, kept as the reference compareJsonExtraction checks against.
+// All of them return false with error set if the JSON is malformed.
+
+// What is kept from a movie details response (requested with append_to_response=credits)
+struct MovieDetails {
+    std::optional<int> statusCode;                  // Only set on TMDB error responses
+    std::string title;                              // "N/A" when missing
+    std::vector<std::pair<int, std::string>> cast;  // pair is <actorID, name>, entries without an ID are skipped
+};
+
+// title, credits.cast[].id and credits.cast[].name
+bool extractMovieDetails(const std::string& body, MovieDetails& details, std::string& error);
+bool extractMovieDetailsDom(const std::string& body, MovieDetails& details, std::string& error);
+
+// results[].id of a discover page, in page order (empty once the pages run out)
+bool extractDiscoverIds(const std::string& body, std::vector<int>& movieIDs, std::string& error);
+bool extractDiscoverIdsDom(const std::string& body, std::vector<int>& movieIDs, std::string& error);
+
+#endif // TMDBPARSER_H